@@ -1,17 +1,45 @@
 #include "example_test_suite.h"
 
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/scene_tree_timer.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+
+#include <atomic>
+#include <vector>
+
 namespace godot
 {
     ExampleTestSuite::ExampleTestSuite()
     {
         REGISTER_TEST_CASE(ExampleTestCase1, example_test_case_1);
         REGISTER_TEST_CASE(ExampleTestCase2, example_test_case_2);
+        REGISTER_TEST_CASE(ExampleBenchmarkCase, example_benchmark_case);
+        REGISTER_TEST_CASE(ExampleAsyncTestCase, example_async_test_case);
+        REGISTER_TEST_CASE(ExampleStressTestCase, example_stress_test_case);
+        REGISTER_TEST_CASE(ExampleAllocationTestCase, example_allocation_test_case);
+        REGISTER_TEST_CASE(ExampleArrayTestCase, example_array_test_case);
+        REGISTER_TEST_CASE(ExamplePropertyTestCase, example_property_test_case);
+        REGISTER_TEST_CASE(ExampleRegressionCase, example_regression_case);
+        REGISTER_TEST_CASE(ExampleContainerTestCase, example_container_test_case);
+        REGISTER_TEST_CASE(ExampleSnapshotTestCase, example_snapshot_test_case);
     }
 
     void ExampleTestSuite::_bind_methods()
     {
         BIND_TEST_CASE(ExampleTestSuite, ExampleTestCase1, example_test_case_1);
         BIND_TEST_CASE(ExampleTestSuite, ExampleTestCase2, example_test_case_2);
+        BIND_TEST_CASE(ExampleTestSuite, ExampleBenchmarkCase, example_benchmark_case);
+        BIND_TEST_CASE(ExampleTestSuite, ExampleAsyncTestCase, example_async_test_case);
+        BIND_TEST_CASE(ExampleTestSuite, ExampleStressTestCase, example_stress_test_case);
+        BIND_TEST_CASE(ExampleTestSuite, ExampleAllocationTestCase, example_allocation_test_case);
+        BIND_TEST_CASE(ExampleTestSuite, ExampleArrayTestCase, example_array_test_case);
+        BIND_TEST_CASE(ExampleTestSuite, ExamplePropertyTestCase, example_property_test_case);
+        BIND_TEST_CASE(ExampleTestSuite, ExampleRegressionCase, example_regression_case);
+        BIND_TEST_CASE(ExampleTestSuite, ExampleContainerTestCase, example_container_test_case);
+        BIND_TEST_CASE(ExampleTestSuite, ExampleSnapshotTestCase, example_snapshot_test_case);
     }
 
     DEFINE_TEST_CASE(ExampleTestSuite, ExampleTestCase1, example_test_case_1)
@@ -40,4 +68,170 @@ namespace godot
         CHECK_NO_ERRORS(true_with_error());
         CHECK_SOME_ERRORS(true_with_error());
     }
+
+    DEFINE_BENCHMARK_CASE(ExampleTestSuite, ExampleBenchmarkCase, example_benchmark_case)
+    {
+        PackedInt64Array values;
+        values.resize(1000);
+        for (std::int64_t i = 0; i < values.size(); ++i)
+            values[i] = i;
+
+        BENCHMARK("sum 1000 integers", [&]()
+        {
+            std::int64_t sum = 0;
+            for (std::int64_t i = 0; i < values.size(); ++i)
+                sum += values[i];
+            return sum;
+        }());
+
+        BENCHMARK("string concatenation", String("Hello, ") + String("World!"));
+    }
+
+    DEFINE_ASYNC_TEST_CASE(ExampleTestSuite, ExampleAsyncTestCase, example_async_test_case)
+    {
+        std::uint64_t start_frame = Engine::get_singleton()->get_process_frames();
+
+        await_process_frames(2, [=]()
+        {
+            CHECK_GREATER_OR_EQUAL(Engine::get_singleton()->get_process_frames(), start_frame + 2);
+
+            SceneTree* scene_tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+            Ref<SceneTreeTimer> timer = scene_tree->create_timer(0.1);
+            await_signal(timer.ptr(), "timeout", 1.0, [=]()
+            {
+                CHECK_LESS_OR_EQUAL(timer->get_time_left(), 0.0);
+            });
+        });
+    }
+
+    DEFINE_STRESS_TEST_CASE(ExampleTestSuite, ExampleStressTestCase, example_stress_test_case)
+    {
+        std::atomic<std::int64_t> counter = 0;
+
+        STRESS("atomic counter", [&](std::int64_t thread_index, std::int64_t iteration)
+        {
+            std::int64_t previous = counter.fetch_add(1, std::memory_order_relaxed);
+            CHECK_GREATER_OR_EQUAL(previous, iteration);
+        });
+    }
+
+    DEFINE_TEST_CASE(ExampleTestSuite, ExampleAllocationTestCase, example_allocation_test_case)
+    {
+        std::int64_t values[] = {1, 2, 3, 4};
+
+        CHECK_NO_ALLOCATIONS(values[0] + values[1] + values[2] + values[3]);
+        CHECK_NO_ALLOCATIONS(String("Hello, ") + String("World!"));
+
+        CHECK_MAX_ALLOCATIONS(std::vector<std::int64_t>(std::begin(values), std::end(values)), 1);
+        CHECK_MAX_ALLOCATIONS(std::vector<std::vector<std::int64_t>>(4, std::vector<std::int64_t>(4)), 1);
+    }
+
+    DEFINE_TEST_CASE(ExampleTestSuite, ExampleArrayTestCase, example_array_test_case)
+    {
+        PackedFloat32Array expected;
+        PackedFloat32Array actual;
+        for (std::int64_t i = 0; i < 1000; ++i)
+        {
+            expected.push_back(0.1f * i);
+            actual.push_back(0.1f * i + 1.0e-6f);
+        }
+
+        CHECK_ARRAYS_EQUAL(expected, expected);
+        CHECK_ARRAYS_EQUAL(expected, actual);
+
+        CHECK_ARRAYS_APPROX_EQUAL(expected, actual, Testing::ArrayTolerance::absolute(1.0e-5));
+        CHECK_ARRAYS_APPROX_EQUAL(expected, actual, Testing::ArrayTolerance::ulps(1));
+    }
+
+    DEFINE_TEST_CASE(ExampleTestSuite, ExamplePropertyTestCase, example_property_test_case)
+    {
+        CHECK_PROPERTY("addition is commutative", Testing::for_all(Testing::Generate::integers(), Testing::Generate::integers()), [](std::int64_t a, std::int64_t b)
+        {
+            return a + b == b + a;
+        });
+
+        // Shrinks to a string of 3 characters, the shortest one that fails
+        CHECK_PROPERTY("strings are short", Testing::for_all(Testing::Generate::strings()), [](const String& string)
+        {
+            return string.length() < 3;
+        });
+    }
+
+    DEFINE_BENCHMARK_CASE(ExampleTestSuite, ExampleRegressionCase, example_regression_case)
+    {
+        PackedInt64Array values;
+        values.resize(1000);
+        for (std::int64_t i = 0; i < values.size(); ++i)
+            values[i] = i;
+
+        auto sum = [&](std::int64_t passes)
+        {
+            std::int64_t total = 0;
+            for (std::int64_t pass = 0; pass < passes; ++pass)
+            {
+                for (std::int64_t i = 0; i < values.size(); ++i)
+                    total += values[i];
+            }
+            return total;
+        };
+
+        // The scene keeps the baseline outside of the project; run once with --update-baselines to record it
+        CHECK_NO_REGRESSION("sum 1000 integers", sum(1));
+
+        // Ten passes are slower than the baseline, unless they would replace it
+        if (!get_update_baselines() && !get_update_all_baselines())
+            CHECK_NO_REGRESSION("sum 1000 integers", sum(10));
+    }
+
+    DEFINE_TEST_CASE(ExampleTestSuite, ExampleContainerTestCase, example_container_test_case)
+    {
+        Array items;
+        for (std::int64_t i = 0; i < 100; ++i)
+        {
+            Dictionary item;
+            item["id"] = i;
+            item["name"] = vformat("item %s", i);
+            items.push_back(item);
+        }
+
+        Array changed_items = items.duplicate(true);
+        Dictionary(changed_items[3])["name"] = "renamed";
+        changed_items.remove_at(50);
+        changed_items.push_back(Dictionary());
+
+        CHECK_CONTAINERS_EQUAL(items, items.duplicate(true));
+        CHECK_CONTAINERS_EQUAL(items, changed_items);
+
+        // Dictionaries are equal if they have the same pairs, in any order
+        Dictionary settings;
+        settings["width"] = 1920;
+        settings["height"] = 1080;
+        Dictionary reordered_settings;
+        reordered_settings["height"] = 1080;
+        reordered_settings["width"] = 1920;
+        CHECK_CONTAINERS_EQUAL(settings, reordered_settings);
+        CHECK_CONTAINERS_EQUAL(Array::make(settings), Array::make(reordered_settings));
+    }
+
+    DEFINE_TEST_CASE(ExampleTestSuite, ExampleSnapshotTestCase, example_snapshot_test_case)
+    {
+        // The vertices of a generated grid
+        auto make_grid = [](std::int64_t size, real_t spacing)
+        {
+            PackedVector3Array vertices;
+            for (std::int64_t z = 0; z <= size; ++z)
+            {
+                for (std::int64_t x = 0; x <= size; ++x)
+                    vertices.push_back(Vector3(x * spacing, 0.0, z * spacing));
+            }
+            return vertices;
+        };
+
+        // The scene keeps the snapshot outside of the project; run once with --update-snapshots to record it
+        CHECK_MATCHES_SNAPSHOT(make_grid(16, 1.0), "grid");
+
+        // A wider spacing no longer matches, unless it would replace the snapshot
+        if (!get_update_snapshots() && !get_update_all_snapshots())
+            CHECK_MATCHES_SNAPSHOT(make_grid(16, 1.5), "grid");
+    }
 }
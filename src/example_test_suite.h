@@ -14,6 +14,15 @@ namespace godot
 
         DECLARE_TEST_CASE(ExampleTestCase1, example_test_case_1);
         DECLARE_TEST_CASE(ExampleTestCase2, example_test_case_2);
+        DECLARE_BENCHMARK_CASE(ExampleBenchmarkCase, example_benchmark_case);
+        DECLARE_ASYNC_TEST_CASE(ExampleAsyncTestCase, example_async_test_case);
+        DECLARE_STRESS_TEST_CASE(ExampleStressTestCase, example_stress_test_case);
+        DECLARE_TEST_CASE(ExampleAllocationTestCase, example_allocation_test_case);
+        DECLARE_TEST_CASE(ExampleArrayTestCase, example_array_test_case);
+        DECLARE_TEST_CASE(ExamplePropertyTestCase, example_property_test_case);
+        DECLARE_BENCHMARK_CASE(ExampleRegressionCase, example_regression_case);
+        DECLARE_TEST_CASE(ExampleContainerTestCase, example_container_test_case);
+        DECLARE_TEST_CASE(ExampleSnapshotTestCase, example_snapshot_test_case);
 
     protected:
         static void _bind_methods();
@@ -5,7 +5,17 @@
 #include <godot_cpp/godot.hpp>
 
 #include "testing/test_case.h"
+#include "testing/benchmark_case.h"
+#include "testing/async_test_case.h"
+#include "testing/stress_test_case.h"
+#include "testing/output_sink.h"
+#include "testing/test_report.h"
+#include "testing/report_writer.h"
 #include "testing/test_suite.h"
+#include "testing/test_runner.h"
+#include "testing/test_result_cache.h"
+#include "testing/test_impact_map.h"
+#include "testing/shard_coordinator.h"
 
 #include "example_test_suite.h"
 
@@ -16,8 +26,20 @@ void initialize_gdext_testing_module(ModuleInitializationLevel p_level)
     if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE)
         return;
 
+    GDREGISTER_CLASS(Testing::OutputSink);
+    GDREGISTER_CLASS(Testing::TestReport);
+    GDREGISTER_ABSTRACT_CLASS(Testing::ReportWriter);
+    GDREGISTER_CLASS(Testing::JUnitReportWriter);
+    GDREGISTER_CLASS(Testing::JsonReportWriter);
     GDREGISTER_ABSTRACT_CLASS(Testing::TestCase);
+    GDREGISTER_ABSTRACT_CLASS(Testing::BenchmarkCase);
+    GDREGISTER_ABSTRACT_CLASS(Testing::AsyncTestCase);
+    GDREGISTER_ABSTRACT_CLASS(Testing::StressTestCase);
     GDREGISTER_CLASS(Testing::TestSuite);
+    GDREGISTER_CLASS(Testing::TestResultCache);
+    GDREGISTER_CLASS(Testing::TestImpactMap);
+    GDREGISTER_CLASS(Testing::ShardCoordinator);
+    GDREGISTER_CLASS(Testing::TestRunner);
 
     GDREGISTER_CLASS(ExampleTestSuite);
 }
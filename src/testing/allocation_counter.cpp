@@ -0,0 +1,198 @@
+#include "testing/allocation_counter.h"
+
+#include <godot_cpp/classes/os.hpp>
+
+#ifdef GDEXT_TESTING_ALLOCATION_HOOKS
+#include <cstdlib>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+#endif
+
+namespace godot::Testing
+{
+#ifdef GDEXT_TESTING_ALLOCATION_HOOKS
+    // Plain integers, so that the hooks never depend on thread-local constructors
+    static thread_local std::int64_t thread_allocations = 0;
+    static thread_local std::int64_t thread_allocated_bytes = 0;
+
+    static void* counted_allocate(std::size_t size, std::size_t alignment)
+    {
+        thread_allocations++;
+        thread_allocated_bytes += std::int64_t(size);
+
+        if (size == 0)
+            size = 1;
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+#ifdef _MSC_VER
+            return _aligned_malloc(size, alignment);
+#else
+            // aligned_alloc needs the size to be a multiple of the alignment
+            return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+        }
+        return std::malloc(size);
+    }
+
+    // MSVC has no aligned_alloc, and what _aligned_malloc returns can only be freed by _aligned_free
+    static void counted_free(void* pointer, std::size_t alignment)
+    {
+#ifdef _MSC_VER
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            _aligned_free(pointer);
+            return;
+        }
+#endif
+        std::free(pointer);
+    }
+
+    static void* checked_allocate(std::size_t size, std::size_t alignment)
+    {
+        void* pointer = counted_allocate(size, alignment);
+        if (pointer == nullptr)
+        {
+#ifdef __cpp_exceptions
+            throw std::bad_alloc();
+#else
+            std::abort();
+#endif
+        }
+        return pointer;
+    }
+#endif
+
+    bool is_allocation_counting_available()
+    {
+#ifdef GDEXT_TESTING_ALLOCATION_HOOKS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool is_static_memory_tracked()
+    {
+        return OS::get_singleton()->is_debug_build();
+    }
+
+    AllocationCounts get_allocation_counts()
+    {
+        AllocationCounts counts;
+#ifdef GDEXT_TESTING_ALLOCATION_HOOKS
+        counts.allocations = thread_allocations;
+        counts.bytes = thread_allocated_bytes;
+#endif
+        counts.static_memory_change = std::int64_t(OS::get_singleton()->get_static_memory_usage());
+        return counts;
+    }
+}
+
+#ifdef GDEXT_TESTING_ALLOCATION_HOOKS
+// Replacements for the global allocation functions, which count every allocation made by code in
+// this library (linked with -Bsymbolic-functions so that its own calls bind to these). Godot's own
+// allocations, such as those of String and Array, go through Godot's allocator and are only seen
+// in its static memory usage.
+
+void* operator new(std::size_t size)
+{
+    return godot::Testing::checked_allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return godot::Testing::counted_allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return godot::Testing::counted_allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return godot::Testing::checked_allocate(size, std::size_t(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return godot::Testing::counted_allocate(size, std::size_t(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return godot::Testing::counted_allocate(size, std::size_t(alignment));
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t alignment) noexcept
+{
+    godot::Testing::counted_free(pointer, std::size_t(alignment));
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept
+{
+    godot::Testing::counted_free(pointer, std::size_t(alignment));
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    godot::Testing::counted_free(pointer, std::size_t(alignment));
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept
+{
+    godot::Testing::counted_free(pointer, std::size_t(alignment));
+}
+
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    godot::Testing::counted_free(pointer, std::size_t(alignment));
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    godot::Testing::counted_free(pointer, std::size_t(alignment));
+}
+#endif
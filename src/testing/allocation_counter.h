@@ -0,0 +1,57 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+#include <type_traits>
+
+namespace godot::Testing
+{
+    // Heap allocations made while evaluating an expression. The number of allocations and the
+    // bytes allocated are counted on the calling thread by replacing the global operator new, which
+    // only happens in builds made with "scons allocation_hooks=yes", and only covers allocations
+    // made by code in this library. Godot's own allocations (such as those of String, Array, the
+    // packed arrays, and memnew) go through Godot's allocator instead, and only show up in the
+    // change in Godot's static memory usage. That change is always available (in debug builds of
+    // Godot), but covers every thread, and only the memory that is still held afterwards.
+    struct AllocationCounts
+    {
+        std::int64_t allocations = 0;
+        std::int64_t bytes = 0;
+        std::int64_t static_memory_change = 0;
+
+        AllocationCounts operator-(const AllocationCounts& other) const
+        {
+            return {allocations - other.allocations, bytes - other.bytes, static_memory_change - other.static_memory_change};
+        }
+    };
+
+    // Whether the allocations and bytes of AllocationCounts are counted in this build
+    bool is_allocation_counting_available();
+
+    // Whether Godot keeps track of its static memory usage, which it only does in debug builds
+    bool is_static_memory_tracked();
+
+    // The running totals for the calling thread (and for Godot's static memory usage)
+    AllocationCounts get_allocation_counts();
+
+    template <class Function>
+    AllocationCounts count_allocations(Function&& function)
+    {
+        AllocationCounts counts_before = get_allocation_counts();
+        if constexpr (std::is_void_v<std::invoke_result_t<Function&>>)
+        {
+            function();
+            return get_allocation_counts() - counts_before;
+        }
+        else
+        {
+            // The result is only destroyed once the counts are taken, so that the memory it holds
+            // (such as the buffer of a String) still shows up in Godot's static memory usage
+            auto&& result = function();
+            static_cast<void>(result);
+            return get_allocation_counts() - counts_before;
+        }
+    }
+}
+
+#endif
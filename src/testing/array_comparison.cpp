@@ -0,0 +1,257 @@
+#include "testing/array_comparison.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace godot::Testing
+{
+    // A multiple of every component count, so that blocks always start at an element, and of
+    // every vector width, so that the fast pass over a whole block needs no scalar remainder (GCC
+    // only vectorizes loops like that at -O2)
+    static constexpr std::int64_t BLOCK_COMPONENTS = 768;
+
+    // Whether x < y as 1 or 0, from bitwise operations and a subtraction only, so that the fast pass
+    // also vectorizes for 64-bit lanes, which SSE2 has no comparisons for (Hacker's Delight 2-12)
+    template <class Bits>
+    static Bits unsigned_less(Bits x, Bits y)
+    {
+        constexpr int SIGN_SHIFT = sizeof(Bits) * 8 - 1;
+        return Bits(Bits(Bits(~x & y) | Bits(Bits(~(x ^ y)) & Bits(x - y))) >> SIGN_SHIFT);
+    }
+
+    // The same for the two's complement values held in x and y
+    template <class Bits>
+    static Bits signed_less(Bits x, Bits y)
+    {
+        constexpr int SIGN_SHIFT = sizeof(Bits) * 8 - 1;
+        Bits difference = Bits(x - y);
+        return Bits(Bits(difference ^ Bits(Bits(x ^ y) & Bits(difference ^ x))) >> SIGN_SHIFT);
+    }
+
+    // The fast pass below works on integers as wide as the components, so that every lane of the
+    // vectorized loop has the same width, and without comparisons whose results are converted to
+    // integers (which GCC does not consider worth vectorizing at -O2 for 64-bit lanes). It may
+    // take a match for a mismatch, which the exact check in the slow pass then clears, but never
+    // the other way around.
+    template <class Component, class = void>
+    struct ComponentKernel;
+
+    template <class Component>
+    struct ComponentKernel<Component, std::enable_if_t<std::is_floating_point_v<Component>>>
+    {
+        using Bits = std::conditional_t<sizeof(Component) == 4, std::int32_t, std::int64_t>;
+        using UnsignedBits = std::make_unsigned_t<Bits>;
+        using Error = Component;
+
+        static constexpr int SIGN_SHIFT = sizeof(Bits) * 8 - 1;
+        static constexpr UnsignedBits EXPONENT_MASK = sizeof(Component) == 4 ? UnsignedBits(0x7f800000) : UnsignedBits(0x7ff0000000000000);
+
+        Component absolute_tolerance;
+        Component relative_tolerance;
+        UnsignedBits max_ulps;
+        // max_ulps times the ULP of 1
+        Component ulp_tolerance;
+
+        explicit ComponentKernel(const ArrayTolerance& tolerance) :
+            absolute_tolerance(Component(tolerance.absolute_tolerance)),
+            relative_tolerance(Component(tolerance.relative_tolerance)),
+            max_ulps(UnsignedBits(std::clamp<std::int64_t>(tolerance.max_ulps, 0, std::numeric_limits<Bits>::max()))),
+            ulp_tolerance(Component(max_ulps) * std::numeric_limits<Component>::epsilon())
+        {
+        }
+
+        static UnsignedBits to_bits(Component value)
+        {
+            UnsignedBits bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        static Component from_bits(UnsignedBits bits)
+        {
+            Component value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        // Maps the bits of a value to an integer that is ordered like the values, so that the
+        // distance between two of them is their distance in ULPs
+        static Bits to_ordered_bits(Component value)
+        {
+            Bits bits = Bits(to_bits(value));
+            return bits ^ ((bits >> SIGN_SHIFT) & std::numeric_limits<Bits>::max());
+        }
+
+        // 1 if y - x is a number that is not negative, which is never the case if either is NaN
+        static UnsignedBits is_not_greater(Component x, Component y)
+        {
+            return unsigned_less(to_bits(y - x), UnsignedBits(EXPONENT_MASK + 1));
+        }
+
+        // The power of two that a magnitude is in (0 for zeros and subnormals)
+        static Component get_binade(Component magnitude)
+        {
+            return from_bits(to_bits(magnitude) & EXPONENT_MASK);
+        }
+
+        // 1 if the components match and their error is at most max_error. ULPs are measured in
+        // those of the smaller magnitude, which are the smallest steps between two values of the
+        // same sign, so this never allows more than max_ulps.
+        UnsignedBits matches_fast(Component a, Component b, Error max_error) const
+        {
+            Component error = std::fabs(a - b);
+            Component magnitude_a = std::fabs(a);
+            Component magnitude_b = std::fabs(b);
+            UnsignedBits same_sign = UnsignedBits(1) ^ ((to_bits(a) ^ to_bits(b)) >> SIGN_SHIFT);
+
+            UnsignedBits within_absolute = is_not_greater(error, absolute_tolerance);
+            UnsignedBits within_relative = is_not_greater(error, relative_tolerance * magnitude_a) | is_not_greater(error, relative_tolerance * magnitude_b);
+            UnsignedBits within_ulps = is_not_greater(error, ulp_tolerance * get_binade(magnitude_a)) & is_not_greater(error, ulp_tolerance * get_binade(magnitude_b)) & same_sign;
+            return (within_absolute | within_relative | within_ulps) & is_not_greater(error, max_error);
+        }
+
+        bool matches(Component a, Component b) const
+        {
+            Component error = std::fabs(a - b);
+            Component scale = std::max(std::fabs(a), std::fabs(b));
+
+            // Only compared in ULPs if both are numbers, since NaN bit patterns can be close
+            Bits ordered_a = to_ordered_bits(a);
+            Bits ordered_b = to_ordered_bits(b);
+            UnsignedBits ulp_distance = ordered_a > ordered_b ? UnsignedBits(ordered_a) - UnsignedBits(ordered_b) : UnsignedBits(ordered_b) - UnsignedBits(ordered_a);
+            return error <= absolute_tolerance || error <= relative_tolerance * scale || (ulp_distance <= max_ulps && a == a && b == b);
+        }
+
+        // NaN counts as 0 (it is a mismatch instead)
+        static Error error(Component a, Component b)
+        {
+            Component error = std::fabs(a - b);
+            return error == error ? error : Component(0);
+        }
+    };
+
+    template <class Component>
+    struct ComponentKernel<Component, std::enable_if_t<std::is_integral_v<Component>>>
+    {
+        using UnsignedBits = std::make_unsigned_t<Component>;
+        using Error = UnsignedBits;
+
+        UnsignedBits absolute_tolerance;
+        double relative_tolerance;
+
+        // ULPs of an integer are just its units
+        explicit ComponentKernel(const ArrayTolerance& tolerance) :
+            absolute_tolerance(saturate(std::max(std::floor(tolerance.absolute_tolerance), double(tolerance.max_ulps)))),
+            relative_tolerance(tolerance.relative_tolerance)
+        {
+        }
+
+        // The largest value of a 64-bit type rounds up to 2^64 as a double, which does not convert
+        // back, so anything from 2^digits up saturates explicitly (and NaN counts as 0)
+        static UnsignedBits saturate(double value)
+        {
+            if (!(value > 0.0))
+                return 0;
+            if (value >= std::ldexp(1.0, std::numeric_limits<UnsignedBits>::digits))
+                return std::numeric_limits<UnsignedBits>::max();
+            return UnsignedBits(value);
+        }
+
+        // Unsigned, so that the difference cannot overflow
+        static UnsignedBits difference(Component a, Component b)
+        {
+            UnsignedBits a_less = std::is_signed_v<Component> ? signed_less(UnsignedBits(a), UnsignedBits(b)) : unsigned_less(UnsignedBits(a), UnsignedBits(b));
+            // Negated if a < b, as (d ^ -1) + 1
+            UnsignedBits negate = UnsignedBits(-a_less);
+            return UnsignedBits(UnsignedBits(UnsignedBits(UnsignedBits(a) - UnsignedBits(b)) ^ negate) + a_less);
+        }
+
+        // Only checks the absolute tolerance, so it may take a match within the relative
+        // tolerance for a mismatch
+        UnsignedBits matches_fast(Component a, Component b, Error max_error) const
+        {
+            UnsignedBits error = difference(a, b);
+            return UnsignedBits(1) ^ (unsigned_less(absolute_tolerance, error) | unsigned_less(max_error, error));
+        }
+
+        bool matches(Component a, Component b) const
+        {
+            double scale = std::max(std::fabs(double(a)), std::fabs(double(b)));
+            return difference(a, b) <= absolute_tolerance || double(difference(a, b)) <= relative_tolerance * scale;
+        }
+
+        static Error error(Component a, Component b)
+        {
+            return difference(a, b);
+        }
+    };
+
+    template <class Component>
+    ArrayComparison compare_array_components(const Component* a, const Component* b, std::int64_t count, std::int64_t components_per_element, const ArrayTolerance& tolerance)
+    {
+        using Kernel = ComponentKernel<Component>;
+        using UnsignedBits = typename Kernel::UnsignedBits;
+        using Error = typename Kernel::Error;
+
+        ArrayComparison comparison;
+        comparison.size_a = count;
+        comparison.size_b = count;
+
+        const Kernel kernel(tolerance);
+        Error max_error = 0;
+
+        std::int64_t component_count = count * components_per_element;
+        for (std::int64_t block_start = 0; block_start < component_count; block_start += BLOCK_COMPONENTS)
+        {
+            std::int64_t block_end = std::min(block_start + BLOCK_COMPONENTS, component_count);
+
+            // The fast pass only finds out whether any component mismatches or raises the largest
+            // error. It runs over whole blocks only (the last, shorter one always takes the slow
+            // pass), so that its trip count is a constant.
+            if (block_end - block_start == BLOCK_COMPONENTS)
+            {
+                const Component* block_a = a + block_start;
+                const Component* block_b = b + block_start;
+                UnsignedBits block_misses = 0;
+                for (std::int64_t i = 0; i < BLOCK_COMPONENTS; ++i)
+                    block_misses |= kernel.matches_fast(block_a[i], block_b[i], max_error) ^ UnsignedBits(1);
+
+                if (block_misses == 0)
+                    continue;
+            }
+
+            // The slow pass finds the mismatching elements and where the largest error is
+            for (std::int64_t element_start = block_start; element_start < block_end; element_start += components_per_element)
+            {
+                bool element_matches = true;
+                for (std::int64_t i = element_start; i < element_start + components_per_element; ++i)
+                {
+                    element_matches &= kernel.matches(a[i], b[i]);
+
+                    Error error = Kernel::error(a[i], b[i]);
+                    if (error > max_error)
+                    {
+                        max_error = error;
+                        comparison.max_error = double(error);
+                        comparison.max_error_index = element_start / components_per_element;
+                    }
+                }
+
+                if (element_matches)
+                    continue;
+                comparison.mismatches++;
+                if (comparison.first_mismatches.size() < ArrayComparison::MAX_LISTED_MISMATCHES)
+                    comparison.first_mismatches.push_back(element_start / components_per_element);
+            }
+        }
+        return comparison;
+    }
+
+    template ArrayComparison compare_array_components(const float*, const float*, std::int64_t, std::int64_t, const ArrayTolerance&);
+    template ArrayComparison compare_array_components(const double*, const double*, std::int64_t, std::int64_t, const ArrayTolerance&);
+    template ArrayComparison compare_array_components(const std::int32_t*, const std::int32_t*, std::int64_t, std::int64_t, const ArrayTolerance&);
+    template ArrayComparison compare_array_components(const std::int64_t*, const std::int64_t*, std::int64_t, std::int64_t, const ArrayTolerance&);
+    template ArrayComparison compare_array_components(const std::uint8_t*, const std::uint8_t*, std::int64_t, std::int64_t, const ArrayTolerance&);
+}
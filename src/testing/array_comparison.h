@@ -0,0 +1,147 @@
+#ifndef ARRAY_COMPARISON_H
+#define ARRAY_COMPARISON_H
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_float64_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_vector3_array.hpp>
+#include <godot_cpp/variant/packed_vector4_array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace godot::Testing
+{
+    // How far apart two elements of a packed array may be while still counting as equal. Two
+    // components match if they are within any one of the tolerances (or are exactly equal).
+    struct ArrayTolerance
+    {
+        double absolute_tolerance = 0.0;
+        // Relative to the larger magnitude of the two components
+        double relative_tolerance = 0.0;
+        // Units in the last place, for float and double components
+        std::int64_t max_ulps = 0;
+
+        static ArrayTolerance absolute(double tolerance) { return ArrayTolerance().with_absolute(tolerance); }
+        static ArrayTolerance relative(double tolerance) { return ArrayTolerance().with_relative(tolerance); }
+        static ArrayTolerance ulps(std::int64_t max_ulps) { return ArrayTolerance().with_ulps(max_ulps); }
+
+        ArrayTolerance with_absolute(double tolerance) const { ArrayTolerance result = *this; result.absolute_tolerance = tolerance; return result; }
+        ArrayTolerance with_relative(double tolerance) const { ArrayTolerance result = *this; result.relative_tolerance = tolerance; return result; }
+        ArrayTolerance with_ulps(std::int64_t max_ulps) const { ArrayTolerance result = *this; result.max_ulps = max_ulps; return result; }
+    };
+
+    struct ArrayComparison
+    {
+        static constexpr std::size_t MAX_LISTED_MISMATCHES = 5;
+
+        std::int64_t size_a = 0;
+        std::int64_t size_b = 0;
+        // Mismatching elements within the common size
+        std::int64_t mismatches = 0;
+        std::vector<std::int64_t> first_mismatches;
+        // The largest absolute difference between two components, and the element it is in
+        double max_error = 0.0;
+        std::int64_t max_error_index = -1;
+
+        bool is_match() const { return size_a == size_b && mismatches == 0; }
+    };
+
+    // Compares count elements of components_per_element components each. The components are
+    // first checked in blocks by a loop without branches or comparisons that the compiler
+    // vectorizes at -O2 (GCC with SSE2 or NEON), and only blocks with mismatches or a new maximum
+    // error are looked at one element at a time.
+    // Instantiated for float, double, std::int32_t, std::int64_t, and std::uint8_t.
+    template <class Component>
+    ArrayComparison compare_array_components(const Component* a, const Component* b, std::int64_t count, std::int64_t components_per_element, const ArrayTolerance& tolerance);
+
+    // The component type and count of each packed array that can be compared in bulk
+    template <class PackedArray>
+    struct PackedArrayTraits;
+
+#define _PACKED_ARRAY_TRAITS(PackedArray, ComponentType, component_count) \
+    template <> \
+    struct PackedArrayTraits<PackedArray> \
+    { \
+        using Component = ComponentType; \
+        static constexpr std::int64_t COMPONENTS = component_count; \
+    };
+
+    _PACKED_ARRAY_TRAITS(PackedByteArray, std::uint8_t, 1)
+    _PACKED_ARRAY_TRAITS(PackedInt32Array, std::int32_t, 1)
+    _PACKED_ARRAY_TRAITS(PackedInt64Array, std::int64_t, 1)
+    _PACKED_ARRAY_TRAITS(PackedFloat32Array, float, 1)
+    _PACKED_ARRAY_TRAITS(PackedFloat64Array, double, 1)
+    _PACKED_ARRAY_TRAITS(PackedVector2Array, real_t, 2)
+    _PACKED_ARRAY_TRAITS(PackedVector3Array, real_t, 3)
+    _PACKED_ARRAY_TRAITS(PackedVector4Array, real_t, 4)
+    _PACKED_ARRAY_TRAITS(PackedColorArray, float, 4)
+
+#undef _PACKED_ARRAY_TRAITS
+
+    template <class PackedArray>
+    ArrayComparison compare_packed_arrays(const PackedArray& a, const PackedArray& b, const ArrayTolerance& tolerance = ArrayTolerance())
+    {
+        using Traits = PackedArrayTraits<PackedArray>;
+        using Component = typename Traits::Component;
+
+        std::int64_t common_size = std::min(a.size(), b.size());
+        ArrayComparison comparison;
+        if (common_size > 0)
+        {
+            // The vector and color types are plain structs of their components
+            comparison = compare_array_components(reinterpret_cast<const Component*>(a.ptr()), reinterpret_cast<const Component*>(b.ptr()),
+                common_size, Traits::COMPONENTS, tolerance);
+        }
+        comparison.size_a = a.size();
+        comparison.size_b = b.size();
+        return comparison;
+    }
+
+    // Strings are always compared exactly
+    inline ArrayComparison compare_packed_arrays(const PackedStringArray& a, const PackedStringArray& b, const ArrayTolerance& = ArrayTolerance())
+    {
+        ArrayComparison comparison;
+        comparison.size_a = a.size();
+        comparison.size_b = b.size();
+        std::int64_t common_size = std::min(a.size(), b.size());
+        for (std::int64_t i = 0; i < common_size; ++i)
+        {
+            if (a[i] == b[i])
+                continue;
+            comparison.mismatches++;
+            if (comparison.first_mismatches.size() < ArrayComparison::MAX_LISTED_MISMATCHES)
+                comparison.first_mismatches.push_back(i);
+        }
+        return comparison;
+    }
+
+    // The lines describing a comparison, listing the first mismatching elements of both arrays
+    template <class PackedArray>
+    PackedStringArray describe_array_comparison(const ArrayComparison& comparison, const PackedArray& a, const PackedArray& b)
+    {
+        PackedStringArray lines;
+        if (comparison.size_a != comparison.size_b)
+            lines.push_back(vformat("sizes: %s and %s", comparison.size_a, comparison.size_b));
+        else
+            lines.push_back(vformat("size: %s", comparison.size_a));
+
+        lines.push_back(vformat("mismatching elements: %s", comparison.mismatches));
+        for (std::int64_t index : comparison.first_mismatches)
+            lines.push_back(vformat("    [%s]: %s vs %s", index, UtilityFunctions::str(a[index]), UtilityFunctions::str(b[index])));
+        if (comparison.mismatches > std::int64_t(comparison.first_mismatches.size()))
+            lines.push_back(vformat("    ...and %s more", comparison.mismatches - std::int64_t(comparison.first_mismatches.size())));
+
+        if (comparison.max_error_index >= 0)
+            lines.push_back(vformat("max error: %s at [%s]", comparison.max_error, comparison.max_error_index));
+        return lines;
+    }
+}
+
+#endif
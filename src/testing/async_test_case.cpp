@@ -0,0 +1,265 @@
+#include "testing/async_test_case.h"
+
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+
+namespace godot::Testing
+{
+    static std::uint64_t seconds_to_usec(double seconds)
+    {
+        return std::uint64_t(std::max(seconds, 0.0) * 1.0e6);
+    }
+
+    AsyncTestCase::~AsyncTestCase()
+    {
+        if (m_running)
+        {
+            stop_waiting();
+            if (m_scene_tree != nullptr)
+            {
+                m_scene_tree->disconnect("process_frame", callable_mp(this, &AsyncTestCase::on_process_frame));
+                m_scene_tree->disconnect("physics_frame", callable_mp(this, &AsyncTestCase::on_physics_frame));
+            }
+        }
+    }
+
+    void AsyncTestCase::run(bool flush_output)
+    {
+        ERR_FAIL_COND_MSG(m_running, vformat("%s is already running.", get_class()));
+
+        m_scene_tree = Object::cast_to<SceneTree>(Engine::get_singleton()->get_main_loop());
+        m_flush_output = flush_output;
+        begin_run();
+
+        m_running = true;
+        m_error_context = std::make_unique<ErrorHandler::Context>();
+        m_start_usec = Time::get_singleton()->get_ticks_usec();
+        m_deadline_usec = m_timeout_seconds > 0.0 ? m_start_usec + seconds_to_usec(m_timeout_seconds) : 0;
+
+        if (m_scene_tree != nullptr)
+        {
+            m_scene_tree->connect("process_frame", callable_mp(this, &AsyncTestCase::on_process_frame));
+            m_scene_tree->connect("physics_frame", callable_mp(this, &AsyncTestCase::on_physics_frame));
+        }
+
+        resume([this]() { test_body(); });
+    }
+
+    bool AsyncTestCase::is_running() const
+    {
+        return m_running;
+    }
+
+    void AsyncTestCase::cancel()
+    {
+        if (!m_running)
+            return;
+
+        {
+            ErrorHandler::ScopedAttach error_context(*m_error_context);
+            report_check("cancel()", __FILE__, __LINE__, start_check_timer(), CHECK_ERRORED, [&]()
+            {
+                print_output("        the test case was cancelled before it completed");
+            });
+        }
+        complete();
+    }
+
+    void AsyncTestCase::await_process_frames(std::int64_t frame_count, Continuation continuation)
+    {
+        ERR_FAIL_NULL_MSG(m_scene_tree, "Waiting for process frames requires a SceneTree.");
+        if (start_wait(WAIT_PROCESS_FRAMES, std::move(continuation)))
+            m_wait_target = Engine::get_singleton()->get_process_frames() + std::max<std::int64_t>(frame_count, 1);
+    }
+
+    void AsyncTestCase::await_physics_frames(std::int64_t frame_count, Continuation continuation)
+    {
+        ERR_FAIL_NULL_MSG(m_scene_tree, "Waiting for physics frames requires a SceneTree.");
+        if (start_wait(WAIT_PHYSICS_FRAMES, std::move(continuation)))
+            m_wait_target = Engine::get_singleton()->get_physics_frames() + std::max<std::int64_t>(frame_count, 1);
+    }
+
+    void AsyncTestCase::await_seconds(double seconds, Continuation continuation)
+    {
+        ERR_FAIL_NULL_MSG(m_scene_tree, "Waiting for time to pass requires a SceneTree.");
+        if (start_wait(WAIT_SECONDS, std::move(continuation)))
+            m_wait_deadline_usec = Time::get_singleton()->get_ticks_usec() + seconds_to_usec(seconds);
+    }
+
+    void AsyncTestCase::await_signal(Object* object, const StringName& signal, double timeout_seconds, Continuation continuation)
+    {
+        ERR_FAIL_NULL(object);
+        ERR_FAIL_COND_MSG(!object->has_signal(signal), vformat("%s has no signal named %s.", object->get_class(), signal));
+        ERR_FAIL_NULL_MSG(m_scene_tree, "Waiting for a signal requires a SceneTree.");
+        if (!start_wait(WAIT_SIGNAL, std::move(continuation)))
+            return;
+
+        // The connection has to accept (and ignore) however many arguments the signal has
+        std::int64_t argument_count = 0;
+        TypedArray<Dictionary> signal_list = object->get_signal_list();
+        for (std::int64_t i = 0; i < signal_list.size(); ++i)
+        {
+            Dictionary signal_info = signal_list[i];
+            if (StringName(signal_info["name"]) == signal)
+            {
+                argument_count = Array(signal_info["args"]).size();
+                break;
+            }
+        }
+
+        m_signal_emitted = false;
+        m_signal_object_id = object->get_instance_id();
+        m_signal_name = signal;
+        m_signal_callable = callable_mp(this, &AsyncTestCase::on_awaited_signal).unbind(argument_count);
+        m_wait_deadline_usec = timeout_seconds > 0.0 ? Time::get_singleton()->get_ticks_usec() + seconds_to_usec(timeout_seconds) : 0;
+        object->connect(signal, m_signal_callable, CONNECT_ONE_SHOT);
+    }
+
+    bool AsyncTestCase::start_wait(WaitKind kind, Continuation continuation)
+    {
+        ERR_FAIL_COND_V_MSG(!m_running, false, "Can only wait while the test case is running.");
+        ERR_FAIL_COND_V_MSG(m_wait_kind != WAIT_NONE, false, "Each step of a test case can only start one wait.");
+
+        m_wait_kind = kind;
+        m_continuation = std::move(continuation);
+        return true;
+    }
+
+    void AsyncTestCase::resume(const Continuation& step)
+    {
+        {
+            ErrorHandler::ScopedAttach error_context(*m_error_context);
+            step();
+        }
+
+        if (m_running && m_wait_kind == WAIT_NONE)
+            complete();
+    }
+
+    void AsyncTestCase::complete()
+    {
+        stop_waiting();
+        if (m_scene_tree != nullptr)
+        {
+            m_scene_tree->disconnect("process_frame", callable_mp(this, &AsyncTestCase::on_process_frame));
+            m_scene_tree->disconnect("physics_frame", callable_mp(this, &AsyncTestCase::on_physics_frame));
+            m_scene_tree = nullptr;
+        }
+
+        m_running = false;
+        m_duration_usec = Time::get_singleton()->get_ticks_usec() - m_start_usec;
+        end_run(m_flush_output);
+        m_error_context.reset();
+
+        emit_signal("completed");
+    }
+
+    void AsyncTestCase::stop_waiting()
+    {
+        if (m_wait_kind == WAIT_SIGNAL && !m_signal_emitted)
+        {
+            Object* object = ObjectDB::get_instance(m_signal_object_id);
+            if (object != nullptr && object->is_connected(m_signal_name, m_signal_callable))
+                object->disconnect(m_signal_name, m_signal_callable);
+        }
+
+        m_wait_kind = WAIT_NONE;
+        m_continuation = nullptr;
+        m_signal_callable = Callable();
+    }
+
+    bool AsyncTestCase::check_timeout(std::uint64_t now_usec)
+    {
+        if (m_deadline_usec == 0 || now_usec < m_deadline_usec)
+            return false;
+
+        {
+            ErrorHandler::ScopedAttach error_context(*m_error_context);
+            report_check("timeout_seconds", __FILE__, __LINE__, start_check_timer(), CHECK_ERRORED, [&]()
+            {
+                print_output(vformat("        the test case did not complete within %s seconds", m_timeout_seconds));
+            });
+        }
+        complete();
+        return true;
+    }
+
+    void AsyncTestCase::on_process_frame()
+    {
+        if (!m_running)
+            return;
+
+        std::uint64_t now_usec = Time::get_singleton()->get_ticks_usec();
+        if (check_timeout(now_usec))
+            return;
+
+        bool wait_over = false;
+        if (m_wait_kind == WAIT_PROCESS_FRAMES)
+            wait_over = Engine::get_singleton()->get_process_frames() >= m_wait_target;
+        else if (m_wait_kind == WAIT_SECONDS)
+            wait_over = now_usec >= m_wait_deadline_usec;
+        else if (m_wait_kind == WAIT_SIGNAL && m_signal_emitted)
+            wait_over = true;
+        else if (m_wait_kind == WAIT_SIGNAL && m_wait_deadline_usec != 0 && now_usec >= m_wait_deadline_usec)
+        {
+            {
+                ErrorHandler::ScopedAttach error_context(*m_error_context);
+                report_check("await_signal(OBJECT, SIGNAL, TIMEOUT)", __FILE__, __LINE__, start_check_timer(), CHECK_FAILED, [&]()
+                {
+                    print_output(vformat("        SIGNAL: %s", m_signal_name));
+                    print_output("        the signal was not emitted before the timeout");
+                });
+            }
+            complete();
+            return;
+        }
+
+        if (wait_over)
+        {
+            Continuation continuation = std::move(m_continuation);
+            stop_waiting();
+            resume(continuation);
+        }
+    }
+
+    void AsyncTestCase::on_physics_frame()
+    {
+        if (!m_running || m_wait_kind != WAIT_PHYSICS_FRAMES)
+            return;
+
+        if (Engine::get_singleton()->get_physics_frames() >= m_wait_target)
+        {
+            Continuation continuation = std::move(m_continuation);
+            stop_waiting();
+            resume(continuation);
+        }
+    }
+
+    void AsyncTestCase::on_awaited_signal()
+    {
+        // Resume on the next process frame rather than in the middle of the signal emission
+        m_signal_emitted = true;
+    }
+
+    double AsyncTestCase::get_timeout_seconds() const
+    {
+        return m_timeout_seconds;
+    }
+
+    void AsyncTestCase::set_timeout_seconds(double timeout_seconds)
+    {
+        m_timeout_seconds = timeout_seconds;
+    }
+
+    void AsyncTestCase::_bind_methods()
+    {
+        ClassDB::bind_method(D_METHOD("cancel"), &AsyncTestCase::cancel);
+
+        ClassDB::bind_method(D_METHOD("get_timeout_seconds"), &AsyncTestCase::get_timeout_seconds);
+        ClassDB::bind_method(D_METHOD("set_timeout_seconds", "timeout_seconds"), &AsyncTestCase::set_timeout_seconds);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "timeout_seconds", PROPERTY_HINT_RANGE, "0,600,0.1,or_greater,suffix:s"), "set_timeout_seconds", "get_timeout_seconds");
+
+        ADD_SIGNAL(MethodInfo("completed"));
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef ASYNC_TEST_CASE_H
+#define ASYNC_TEST_CASE_H
+
+#include <godot_cpp/classes/scene_tree.hpp>
+
+#include <functional>
+#include <memory>
+
+#include "testing/test_case.h"
+
+namespace godot::Testing
+{
+    // A test case whose body can wait for process frames, physics frames, signals, or time to pass
+    // without blocking the main loop. Each await_*() function takes a continuation, which is run
+    // (under the same error context as the rest of the test case) once the wait is over. The
+    // continuation can start another wait, and the test case completes once a step returns
+    // without starting one. Continuations outlive the step that created them, so they should
+    // capture by value:
+    //
+    //     await_process_frames(2, [=]()
+    //     {
+    //         CHECK_TRUE(node->is_inside_tree());
+    //     });
+    //
+    // run() returns as soon as the first wait starts, and the completed signal is emitted once
+    // the test case is done.
+    class AsyncTestCase : public TestCase
+    {
+        GDCLASS(AsyncTestCase, TestCase)
+
+    public:
+        using TestCase::TestCase;
+        ~AsyncTestCase();
+
+        void run(bool flush_output = true) override;
+        bool is_running() const override;
+
+        // Stops waiting and completes the test case, with an errored check recording the cancellation
+        void cancel();
+
+        double get_timeout_seconds() const;
+        void set_timeout_seconds(double timeout_seconds);
+
+    protected:
+        static void _bind_methods();
+
+        using Continuation = std::function<void()>;
+
+        void await_process_frames(std::int64_t frame_count, Continuation continuation);
+        void await_physics_frames(std::int64_t frame_count, Continuation continuation);
+        void await_seconds(double seconds, Continuation continuation);
+        // If the signal is not emitted within timeout_seconds, a failed check is recorded and the
+        // test case completes without running the continuation
+        void await_signal(Object* object, const StringName& signal, double timeout_seconds, Continuation continuation);
+
+    private:
+        enum WaitKind
+        {
+            WAIT_NONE,
+            WAIT_PROCESS_FRAMES,
+            WAIT_PHYSICS_FRAMES,
+            WAIT_SECONDS,
+            WAIT_SIGNAL
+        };
+
+        bool start_wait(WaitKind kind, Continuation continuation);
+        void resume(const Continuation& step);
+        void complete();
+        void stop_waiting();
+
+        void on_process_frame();
+        void on_physics_frame();
+        void on_awaited_signal();
+
+        // Fails the test case with a timeout unless it is already done
+        bool check_timeout(std::uint64_t now_usec);
+
+        double m_timeout_seconds = 10.0;
+
+        bool m_running = false;
+        bool m_flush_output = true;
+        std::uint64_t m_start_usec = 0;
+        std::uint64_t m_deadline_usec = 0;
+
+        // Errors are captured in the same context across all steps of the test case
+        std::unique_ptr<ErrorHandler::Context> m_error_context;
+
+        SceneTree* m_scene_tree = nullptr;
+
+        WaitKind m_wait_kind = WAIT_NONE;
+        Continuation m_continuation;
+        std::uint64_t m_wait_target = 0;
+        std::uint64_t m_wait_deadline_usec = 0;
+        bool m_signal_emitted = false;
+        std::uint64_t m_signal_object_id = 0;
+        StringName m_signal_name;
+        Callable m_signal_callable;
+    };
+}
+
+#endif
@@ -0,0 +1,417 @@
+#include "testing/benchmark_case.h"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/json.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <cmath>
+#include <mutex>
+
+namespace godot::Testing
+{
+    static double percentile(const std::vector<double>& sorted_samples, double fraction)
+    {
+        if (sorted_samples.empty())
+            return 0.0;
+
+        double position = fraction * double(sorted_samples.size() - 1);
+        std::size_t lower_index = std::size_t(std::floor(position));
+        std::size_t upper_index = std::min(lower_index + 1, sorted_samples.size() - 1);
+        double weight = position - double(lower_index);
+        return sorted_samples[lower_index] * (1.0 - weight) + sorted_samples[upper_index] * weight;
+    }
+
+    BenchmarkStats compute_benchmark_stats(std::vector<double> samples, std::int64_t iterations_per_sample)
+    {
+        BenchmarkStats stats;
+        if (samples.empty())
+            return stats;
+
+        std::sort(samples.begin(), samples.end());
+
+        double sum = 0.0;
+        for (double sample : samples)
+            sum += sample;
+
+        stats.iterations = std::int64_t(samples.size()) * iterations_per_sample;
+        stats.samples = samples.size();
+        stats.min_nsec = samples.front();
+        stats.median_nsec = percentile(samples, 0.5);
+        stats.mean_nsec = sum / double(samples.size());
+        stats.p95_nsec = percentile(samples, 0.95);
+        stats.p99_nsec = percentile(samples, 0.99);
+        stats.ops_per_second = stats.mean_nsec > 0.0 ? 1.0e9 / stats.mean_nsec : 0.0;
+        return stats;
+    }
+
+    RegressionComparison compare_with_baseline(const std::vector<double>& baseline_samples, const std::vector<double>& samples, double tolerance)
+    {
+        RegressionComparison comparison;
+        if (baseline_samples.empty() || samples.empty())
+            return comparison;
+
+        std::vector<double> sorted_baseline = baseline_samples;
+        std::vector<double> sorted_samples = samples;
+        std::sort(sorted_baseline.begin(), sorted_baseline.end());
+        std::sort(sorted_samples.begin(), sorted_samples.end());
+        comparison.baseline_median_nsec = percentile(sorted_baseline, 0.5);
+        comparison.median_nsec = percentile(sorted_samples, 0.5);
+        if (comparison.baseline_median_nsec > 0.0)
+            comparison.median_change = comparison.median_nsec / comparison.baseline_median_nsec - 1.0;
+
+        // Rank the pooled samples (new samples flagged), giving tied values their average rank
+        std::vector<std::pair<double, bool>> pooled;
+        pooled.reserve(baseline_samples.size() + samples.size());
+        for (double sample : baseline_samples)
+            pooled.push_back({sample * (1.0 + tolerance), false});
+        for (double sample : samples)
+            pooled.push_back({sample, true});
+        std::sort(pooled.begin(), pooled.end());
+
+        double rank_sum = 0.0;
+        double tie_correction = 0.0;
+        for (std::size_t i = 0; i < pooled.size();)
+        {
+            std::size_t j = i;
+            while (j < pooled.size() && pooled[j].first == pooled[i].first)
+                ++j;
+            double average_rank = double(i + j + 1) / 2.0;
+            for (std::size_t k = i; k < j; ++k)
+            {
+                if (pooled[k].second)
+                    rank_sum += average_rank;
+            }
+            double tie_count = double(j - i);
+            tie_correction += tie_count * tie_count * tie_count - tie_count;
+            i = j;
+        }
+
+        double n1 = double(samples.size());
+        double n2 = double(baseline_samples.size());
+        double n = n1 + n2;
+        double u = rank_sum - n1 * (n1 + 1.0) / 2.0;
+        double variance = n1 * n2 / 12.0 * ((n + 1.0) - tie_correction / (n * (n - 1.0)));
+        if (variance <= 0.0)
+            return comparison;
+
+        // With a continuity correction, towards the new samples not being slower
+        double z = (u - n1 * n2 / 2.0 - 0.5) / std::sqrt(variance);
+        comparison.p_value = 0.5 * std::erfc(z / std::sqrt(2.0));
+        return comparison;
+    }
+
+    // Baseline files may be read and written by test cases running in parallel
+    static std::mutex baseline_file_mutex;
+
+    static Dictionary load_baselines(const String& path)
+    {
+        if (!FileAccess::file_exists(path))
+            return Dictionary();
+        Variant baselines = JSON::parse_string(FileAccess::get_file_as_string(path));
+        return baselines.get_type() == Variant::DICTIONARY ? Dictionary(baselines) : Dictionary();
+    }
+
+    static String format_distribution(const std::vector<double>& samples)
+    {
+        std::vector<double> sorted_samples = samples;
+        std::sort(sorted_samples.begin(), sorted_samples.end());
+        return vformat("min %s, median %s, p95 %s, max %s (%s samples)", format_nsec(sorted_samples.front()),
+            format_nsec(percentile(sorted_samples, 0.5)), format_nsec(percentile(sorted_samples, 0.95)), format_nsec(sorted_samples.back()),
+            std::int64_t(sorted_samples.size()));
+    }
+
+    String format_nsec(double nsec)
+    {
+        if (nsec < 1.0e3)
+            return vformat("%.2f ns", nsec);
+        else if (nsec < 1.0e6)
+            return vformat("%.2f us", nsec / 1.0e3);
+        else if (nsec < 1.0e9)
+            return vformat("%.2f ms", nsec / 1.0e6);
+        else
+            return vformat("%.2f s", nsec / 1.0e9);
+    }
+
+    void BenchmarkCase::begin_run()
+    {
+        TestCase::begin_run();
+
+        // Benchmarks that were renamed or removed do not keep their results from earlier runs
+        m_last_stats = BenchmarkStats();
+        m_benchmark_results.clear();
+    }
+
+    int BenchmarkCase::report_benchmark(const String& name, const char* file, int line, std::int64_t check_start_nsec, const BenchmarkStats& stats, std::int64_t error_count)
+    {
+        m_last_stats = stats;
+
+        Dictionary results;
+        results["iterations"] = stats.iterations;
+        results["samples"] = stats.samples;
+        results["min_nsec"] = stats.min_nsec;
+        results["median_nsec"] = stats.median_nsec;
+        results["mean_nsec"] = stats.mean_nsec;
+        results["p95_nsec"] = stats.p95_nsec;
+        results["p99_nsec"] = stats.p99_nsec;
+        results["ops_per_second"] = stats.ops_per_second;
+        results["errors"] = error_count;
+        m_benchmark_results[name] = results;
+
+        int check_result = error_count > 0 ? CHECK_ERRORED : CHECK_PASSED;
+        return report_check("BENCHMARK(NAME, EXPR)", file, line, check_start_nsec, check_result, [&]()
+        {
+            print_output(vformat("        NAME: %s", name));
+            print_output(vformat("        iterations: %s (%s samples)", stats.iterations, stats.samples));
+            print_output(vformat("        min: %s", format_nsec(stats.min_nsec)));
+            print_output(vformat("        median: %s", format_nsec(stats.median_nsec)));
+            print_output(vformat("        mean: %s", format_nsec(stats.mean_nsec)));
+            print_output(vformat("        p95: %s", format_nsec(stats.p95_nsec)));
+            print_output(vformat("        p99: %s", format_nsec(stats.p99_nsec)));
+            print_output(vformat("        ops/sec: %.1f", stats.ops_per_second));
+            if (error_count > 0)
+                _PRINT_ERRORED_DETAILS(error_count, get_last_n_errors);
+        });
+    }
+
+    int BenchmarkCase::report_regression_check(const String& name, const char* file, int line, std::int64_t check_start_nsec, const std::vector<double>& samples, std::int64_t error_count)
+    {
+        String key = vformat("%s/%s", this->get_class(), name);
+        bool update_baselines = m_update_baselines || s_update_all_baselines;
+
+        std::vector<double> baseline_samples;
+        Error save_error = OK;
+        {
+            std::lock_guard<std::mutex> lock(baseline_file_mutex);
+            Dictionary baselines = load_baselines(m_baseline_path);
+            if (update_baselines && error_count == 0)
+            {
+                Dictionary baseline;
+                PackedFloat64Array baseline_array;
+                for (double sample : samples)
+                    baseline_array.push_back(sample);
+                baseline["samples"] = baseline_array;
+                baselines[key] = baseline;
+
+                Ref<FileAccess> baseline_file = FileAccess::open(m_baseline_path, FileAccess::WRITE);
+                if (baseline_file.is_valid())
+                    baseline_file->store_string(JSON::stringify(baselines, "\t", true));
+                else
+                    save_error = FileAccess::get_open_error();
+            }
+            else if (baselines.has(key))
+            {
+                Array baseline_array = Dictionary(baselines[key]).get("samples", Array());
+                for (std::int64_t i = 0; i < baseline_array.size(); ++i)
+                    baseline_samples.push_back(baseline_array[i]);
+            }
+        }
+
+        RegressionComparison comparison = compare_with_baseline(baseline_samples, samples, m_regression_tolerance);
+
+        int check_result;
+        if (error_count > 0 || save_error != OK)
+            check_result = CHECK_ERRORED;
+        else if (update_baselines)
+            check_result = CHECK_PASSED;
+        else if (baseline_samples.empty())
+            check_result = CHECK_FAILED;
+        else
+            check_result = comparison.p_value < m_regression_significance ? CHECK_FAILED : CHECK_PASSED;
+
+        return report_check("CHECK_NO_REGRESSION(NAME, EXPR)", file, line, check_start_nsec, check_result, [&]()
+        {
+            print_output(vformat("        NAME: %s", name));
+            if (!samples.empty())
+                print_output(vformat("        current: %s", format_distribution(samples)));
+            if (update_baselines)
+            {
+                if (save_error != OK)
+                    print_output(vformat("        could not write the baseline to %s: %s", m_baseline_path, UtilityFunctions::error_string(save_error)));
+                else if (error_count == 0)
+                    print_output(vformat("        baseline updated in %s", m_baseline_path));
+            }
+            else if (baseline_samples.empty())
+            {
+                print_output(vformat("        no baseline in %s (run with update_baselines to record one)", m_baseline_path));
+            }
+            else
+            {
+                print_output(vformat("        baseline: %s", format_distribution(baseline_samples)));
+                print_output(vformat("        median change: %+.1f%% (tolerance %.1f%%), p = %.4g (significance %.4g)",
+                    comparison.median_change * 100.0, m_regression_tolerance * 100.0, comparison.p_value, m_regression_significance));
+            }
+            if (error_count > 0)
+                _PRINT_ERRORED_DETAILS(error_count, get_last_n_errors);
+        });
+    }
+
+    std::int64_t BenchmarkCase::get_warmup_usec() const
+    {
+        return m_warmup_usec;
+    }
+
+    void BenchmarkCase::set_warmup_usec(std::int64_t warmup_usec)
+    {
+        m_warmup_usec = warmup_usec;
+    }
+
+    std::int64_t BenchmarkCase::get_sample_count() const
+    {
+        return m_sample_count;
+    }
+
+    void BenchmarkCase::set_sample_count(std::int64_t sample_count)
+    {
+        m_sample_count = sample_count;
+    }
+
+    std::int64_t BenchmarkCase::get_min_sample_usec() const
+    {
+        return m_min_sample_usec;
+    }
+
+    void BenchmarkCase::set_min_sample_usec(std::int64_t min_sample_usec)
+    {
+        m_min_sample_usec = min_sample_usec;
+    }
+
+    double BenchmarkCase::get_min_nsec() const
+    {
+        return m_last_stats.min_nsec;
+    }
+
+    double BenchmarkCase::get_median_nsec() const
+    {
+        return m_last_stats.median_nsec;
+    }
+
+    double BenchmarkCase::get_mean_nsec() const
+    {
+        return m_last_stats.mean_nsec;
+    }
+
+    double BenchmarkCase::get_p95_nsec() const
+    {
+        return m_last_stats.p95_nsec;
+    }
+
+    double BenchmarkCase::get_p99_nsec() const
+    {
+        return m_last_stats.p99_nsec;
+    }
+
+    double BenchmarkCase::get_ops_per_second() const
+    {
+        return m_last_stats.ops_per_second;
+    }
+
+    Dictionary BenchmarkCase::get_benchmark_results() const
+    {
+        return m_benchmark_results;
+    }
+
+    String BenchmarkCase::get_baseline_path() const
+    {
+        return m_baseline_path;
+    }
+
+    void BenchmarkCase::set_baseline_path(const String& baseline_path)
+    {
+        m_baseline_path = baseline_path;
+    }
+
+    double BenchmarkCase::get_regression_tolerance() const
+    {
+        return m_regression_tolerance;
+    }
+
+    void BenchmarkCase::set_regression_tolerance(double regression_tolerance)
+    {
+        m_regression_tolerance = regression_tolerance;
+    }
+
+    double BenchmarkCase::get_regression_significance() const
+    {
+        return m_regression_significance;
+    }
+
+    void BenchmarkCase::set_regression_significance(double regression_significance)
+    {
+        m_regression_significance = regression_significance;
+    }
+
+    bool BenchmarkCase::get_update_baselines() const
+    {
+        return m_update_baselines;
+    }
+
+    void BenchmarkCase::set_update_baselines(bool update_baselines)
+    {
+        m_update_baselines = update_baselines;
+    }
+
+    void BenchmarkCase::set_update_all_baselines(bool update_all_baselines)
+    {
+        s_update_all_baselines = update_all_baselines;
+    }
+
+    bool BenchmarkCase::get_update_all_baselines()
+    {
+        return s_update_all_baselines;
+    }
+
+    void BenchmarkCase::_bind_methods()
+    {
+        ClassDB::bind_method(D_METHOD("get_warmup_usec"), &BenchmarkCase::get_warmup_usec);
+        ClassDB::bind_method(D_METHOD("set_warmup_usec", "warmup_usec"), &BenchmarkCase::set_warmup_usec);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "warmup_usec", PROPERTY_HINT_RANGE, "0,10000000,1,or_greater,suffix:us"), "set_warmup_usec", "get_warmup_usec");
+
+        ClassDB::bind_method(D_METHOD("get_sample_count"), &BenchmarkCase::get_sample_count);
+        ClassDB::bind_method(D_METHOD("set_sample_count", "sample_count"), &BenchmarkCase::set_sample_count);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "sample_count", PROPERTY_HINT_RANGE, "1,10000,1,or_greater"), "set_sample_count", "get_sample_count");
+
+        ClassDB::bind_method(D_METHOD("get_min_sample_usec"), &BenchmarkCase::get_min_sample_usec);
+        ClassDB::bind_method(D_METHOD("set_min_sample_usec", "min_sample_usec"), &BenchmarkCase::set_min_sample_usec);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "min_sample_usec", PROPERTY_HINT_RANGE, "1,1000000,1,or_greater,suffix:us"), "set_min_sample_usec", "get_min_sample_usec");
+
+        ClassDB::bind_method(D_METHOD("get_min_nsec"), &BenchmarkCase::get_min_nsec);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "min_nsec", PROPERTY_HINT_NONE, "suffix:ns", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_min_nsec");
+
+        ClassDB::bind_method(D_METHOD("get_median_nsec"), &BenchmarkCase::get_median_nsec);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "median_nsec", PROPERTY_HINT_NONE, "suffix:ns", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_median_nsec");
+
+        ClassDB::bind_method(D_METHOD("get_mean_nsec"), &BenchmarkCase::get_mean_nsec);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "mean_nsec", PROPERTY_HINT_NONE, "suffix:ns", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_mean_nsec");
+
+        ClassDB::bind_method(D_METHOD("get_p95_nsec"), &BenchmarkCase::get_p95_nsec);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "p95_nsec", PROPERTY_HINT_NONE, "suffix:ns", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_p95_nsec");
+
+        ClassDB::bind_method(D_METHOD("get_p99_nsec"), &BenchmarkCase::get_p99_nsec);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "p99_nsec", PROPERTY_HINT_NONE, "suffix:ns", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_p99_nsec");
+
+        ClassDB::bind_method(D_METHOD("get_ops_per_second"), &BenchmarkCase::get_ops_per_second);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "ops_per_second", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_ops_per_second");
+
+        ClassDB::bind_method(D_METHOD("get_benchmark_results"), &BenchmarkCase::get_benchmark_results);
+        ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "benchmark_results", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_benchmark_results");
+
+        ClassDB::bind_method(D_METHOD("get_baseline_path"), &BenchmarkCase::get_baseline_path);
+        ClassDB::bind_method(D_METHOD("set_baseline_path", "baseline_path"), &BenchmarkCase::set_baseline_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "baseline_path", PROPERTY_HINT_FILE, "*.json"), "set_baseline_path", "get_baseline_path");
+
+        ClassDB::bind_method(D_METHOD("get_regression_tolerance"), &BenchmarkCase::get_regression_tolerance);
+        ClassDB::bind_method(D_METHOD("set_regression_tolerance", "regression_tolerance"), &BenchmarkCase::set_regression_tolerance);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "regression_tolerance", PROPERTY_HINT_RANGE, "0,1,0.01,or_greater"), "set_regression_tolerance", "get_regression_tolerance");
+
+        ClassDB::bind_method(D_METHOD("get_regression_significance"), &BenchmarkCase::get_regression_significance);
+        ClassDB::bind_method(D_METHOD("set_regression_significance", "regression_significance"), &BenchmarkCase::set_regression_significance);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "regression_significance", PROPERTY_HINT_RANGE, "0.0001,0.5,0.0001"), "set_regression_significance", "get_regression_significance");
+
+        ClassDB::bind_method(D_METHOD("get_update_baselines"), &BenchmarkCase::get_update_baselines);
+        ClassDB::bind_method(D_METHOD("set_update_baselines", "update_baselines"), &BenchmarkCase::set_update_baselines);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "update_baselines"), "set_update_baselines", "get_update_baselines");
+
+        ClassDB::bind_static_method("BenchmarkCase", D_METHOD("set_update_all_baselines", "update_all_baselines"), &BenchmarkCase::set_update_all_baselines);
+        ClassDB::bind_static_method("BenchmarkCase", D_METHOD("get_update_all_baselines"), &BenchmarkCase::get_update_all_baselines);
+    }
+}
@@ -0,0 +1,218 @@
+#ifndef BENCHMARK_CASE_H
+#define BENCHMARK_CASE_H
+
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <vector>
+
+#include "testing/test_case.h"
+
+namespace godot::Testing
+{
+    // Forces the compiler to assume that value is read, so that the code computing it cannot be
+    // removed as dead code.
+    template <class T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "m"(value) : "memory");
+#else
+        static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+#endif
+    }
+
+    // Forces the compiler to assume that all memory is read and written at this point.
+    inline void clobber_memory()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    struct BenchmarkStats
+    {
+        std::int64_t iterations = 0;
+        std::int64_t samples = 0;
+        double min_nsec = 0.0;
+        double median_nsec = 0.0;
+        double mean_nsec = 0.0;
+        double p95_nsec = 0.0;
+        double p99_nsec = 0.0;
+        double ops_per_second = 0.0;
+    };
+
+    // Takes the per-iteration time (in nanoseconds) of each sample and computes the statistics.
+    BenchmarkStats compute_benchmark_stats(std::vector<double> samples, std::int64_t iterations_per_sample);
+
+    struct RegressionComparison
+    {
+        double baseline_median_nsec = 0.0;
+        double median_nsec = 0.0;
+        // The relative change of the median, such as 0.2 for 20% slower
+        double median_change = 0.0;
+        // The one-sided p-value of the samples being slower than the baseline by more than the tolerance
+        double p_value = 1.0;
+    };
+
+    // Compares samples with baseline samples using a one-sided Mann-Whitney U test (with the
+    // normal approximation, corrected for ties), after scaling the baseline by 1 + tolerance. A
+    // small p-value means that the samples are significantly slower than the tolerance allows.
+    RegressionComparison compare_with_baseline(const std::vector<double>& baseline_samples, const std::vector<double>& samples, double tolerance);
+
+    // Measures function repeatedly: first warming up while calibrating how many iterations make up
+    // one sample, then taking sample_count samples. Returns the per-iteration time (in
+    // nanoseconds) of each sample.
+    template <class Function>
+    std::vector<double> sample_benchmark(Function&& function, std::int64_t warmup_usec, std::int64_t sample_count, std::int64_t min_sample_usec, std::int64_t& r_iterations_per_sample)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        auto run_batch = [&](std::int64_t iterations) -> double
+        {
+            Clock::time_point start = Clock::now();
+            for (std::int64_t i = 0; i < iterations; ++i)
+            {
+                if constexpr (std::is_void_v<std::invoke_result_t<Function&>>)
+                    function();
+                else
+                    do_not_optimize(function());
+                clobber_memory();
+            }
+            Clock::time_point end = Clock::now();
+            return std::chrono::duration<double, std::nano>(end - start).count();
+        };
+
+        const double min_sample_nsec = double(min_sample_usec) * 1000.0;
+        const Clock::duration warmup_duration = std::chrono::microseconds(warmup_usec);
+
+        // Warm up, doubling the batch size until a single batch takes at least min_sample_usec. The
+        // calibration goes on past warmup_usec if it needs to, so that a short warmup does not
+        // leave samples so short that they mostly measure the clock.
+        constexpr std::int64_t MAX_ITERATIONS_PER_SAMPLE = std::int64_t(1) << 40;
+        std::int64_t iterations_per_sample = 1;
+        Clock::time_point warmup_start = Clock::now();
+        bool calibrated = false;
+        do
+        {
+            double batch_nsec = run_batch(iterations_per_sample);
+            calibrated = batch_nsec >= min_sample_nsec || iterations_per_sample >= MAX_ITERATIONS_PER_SAMPLE;
+            if (!calibrated)
+                iterations_per_sample *= 2;
+        }
+        while (!calibrated || Clock::now() - warmup_start < warmup_duration);
+
+        std::vector<double> samples;
+        samples.reserve(std::max<std::int64_t>(sample_count, 1));
+        for (std::int64_t i = 0; i < std::max<std::int64_t>(sample_count, 1); ++i)
+            samples.push_back(run_batch(iterations_per_sample) / double(iterations_per_sample));
+
+        r_iterations_per_sample = iterations_per_sample;
+        return samples;
+    }
+
+    class BenchmarkCase : public TestCase
+    {
+        GDCLASS(BenchmarkCase, TestCase)
+
+    public:
+        using TestCase::TestCase;
+
+        std::int64_t get_warmup_usec() const;
+        void set_warmup_usec(std::int64_t warmup_usec);
+
+        std::int64_t get_sample_count() const;
+        void set_sample_count(std::int64_t sample_count);
+
+        std::int64_t get_min_sample_usec() const;
+        void set_min_sample_usec(std::int64_t min_sample_usec);
+
+        double get_min_nsec() const;
+        double get_median_nsec() const;
+        double get_mean_nsec() const;
+        double get_p95_nsec() const;
+        double get_p99_nsec() const;
+        double get_ops_per_second() const;
+
+        Dictionary get_benchmark_results() const;
+
+        // Baselines for CHECK_NO_REGRESSION, keyed by "BenchmarkCaseClass/NAME". The file is meant
+        // to be checked in along with the project.
+        String get_baseline_path() const;
+        void set_baseline_path(const String& baseline_path);
+
+        // How much slower than its baseline a regression check may be, such as 0.1 for 10%
+        double get_regression_tolerance() const;
+        void set_regression_tolerance(double regression_tolerance);
+
+        // The p-value below which a slowdown beyond the tolerance counts as significant
+        double get_regression_significance() const;
+        void set_regression_significance(double regression_significance);
+
+        // If enabled, regression checks rewrite their baselines with the new samples and pass
+        bool get_update_baselines() const;
+        void set_update_baselines(bool update_baselines);
+
+        // Makes every benchmark case update its baselines, as with update_baselines
+        static void set_update_all_baselines(bool update_all_baselines);
+        static bool get_update_all_baselines();
+
+    protected:
+        static void _bind_methods();
+
+        void begin_run() override;
+
+        template <class Function>
+        int run_benchmark(const String& name, const char* file, int line, Function&& function)
+        {
+            std::int64_t check_start_nsec = start_check_timer();
+            std::int64_t error_count = 0;
+            std::int64_t iterations_per_sample = 0;
+            std::vector<double> samples;
+            SUPPRESS_AND_COUNT_ALL_ERRORS(
+                samples = sample_benchmark(function, m_warmup_usec, m_sample_count, m_min_sample_usec, iterations_per_sample),
+                error_count);
+            return report_benchmark(name, file, line, check_start_nsec, compute_benchmark_stats(std::move(samples), iterations_per_sample), error_count);
+        }
+
+        int report_benchmark(const String& name, const char* file, int line, std::int64_t check_start_nsec, const BenchmarkStats& stats, std::int64_t error_count);
+
+        template <class Function>
+        int check_no_regression(const String& name, const char* file, int line, Function&& function)
+        {
+            std::int64_t check_start_nsec = start_check_timer();
+            std::int64_t error_count = 0;
+            std::int64_t iterations_per_sample = 0;
+            std::vector<double> samples;
+            SUPPRESS_AND_COUNT_ALL_ERRORS(
+                samples = sample_benchmark(function, m_warmup_usec, m_sample_count, m_min_sample_usec, iterations_per_sample),
+                error_count);
+            return report_regression_check(name, file, line, check_start_nsec, samples, error_count);
+        }
+
+        int report_regression_check(const String& name, const char* file, int line, std::int64_t check_start_nsec, const std::vector<double>& samples, std::int64_t error_count);
+
+        std::int64_t m_warmup_usec = 50000;
+        std::int64_t m_sample_count = 100;
+        std::int64_t m_min_sample_usec = 1000;
+
+        BenchmarkStats m_last_stats;
+        Dictionary m_benchmark_results;
+
+        String m_baseline_path = "res://benchmark_baselines.json";
+        double m_regression_tolerance = 0.1;
+        double m_regression_significance = 0.01;
+        bool m_update_baselines = false;
+
+        static inline std::atomic<bool> s_update_all_baselines{false};
+    };
+
+    String format_nsec(double nsec);
+}
+
+#endif
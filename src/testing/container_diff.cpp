@@ -0,0 +1,410 @@
+#include "testing/container_diff.h"
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace godot::Testing
+{
+    // Nested containers deeper than this are only summarized
+    static constexpr int MAX_DIFF_DEPTH = 8;
+    static constexpr std::int64_t MAX_LISTED_ELEMENTS = 3;
+    static constexpr std::int64_t MAX_VALUE_LENGTH = 64;
+
+    namespace
+    {
+        // A run of elements of a that were replaced by a run of elements of b (either may be empty)
+        struct Hunk
+        {
+            std::int64_t a_start = 0;
+            std::int64_t a_count = 0;
+            std::int64_t b_start = 0;
+            std::int64_t b_count = 0;
+        };
+
+        class DiffLines
+        {
+        public:
+            bool is_full() const { return m_lines.size() >= MAX_DIFF_LINES; }
+
+            void add(const String& line)
+            {
+                if (is_full())
+                    m_omitted++;
+                else
+                    m_lines.push_back(line);
+            }
+
+            PackedStringArray finish()
+            {
+                if (m_omitted > 0)
+                    m_lines.push_back(vformat("...and %s more differences", m_omitted));
+                return m_lines;
+            }
+
+        private:
+            PackedStringArray m_lines;
+            std::int64_t m_omitted = 0;
+        };
+    }
+
+    static bool is_container(Variant::Type type)
+    {
+        return type == Variant::ARRAY || type == Variant::DICTIONARY || (type >= Variant::PACKED_BYTE_ARRAY && type < Variant::VARIANT_MAX);
+    }
+
+    static String describe_path(const String& path)
+    {
+        return path.is_empty() ? String("value") : path;
+    }
+
+    // Containers are only summarized by their type and size, so that a large element is never
+    // turned into a string
+    static String describe_value(const Variant& value)
+    {
+        Variant::Type type = value.get_type();
+        if (type == Variant::ARRAY)
+            return vformat("Array(size %s)", Array(value).size());
+        if (type == Variant::DICTIONARY)
+            return vformat("Dictionary(size %s)", Dictionary(value).size());
+        if (is_container(type))
+        {
+            // Packed arrays share their data, so the copy is cheap
+            Variant packed_array = value;
+            return vformat("%s(size %s)", Variant::get_type_name(type), packed_array.call("size"));
+        }
+
+        String string = UtilityFunctions::str(value);
+        if (type == Variant::STRING || type == Variant::STRING_NAME)
+            string = "\"" + string.c_escape() + "\"";
+        if (string.length() > MAX_VALUE_LENGTH)
+            string = string.substr(0, MAX_VALUE_LENGTH) + "...";
+        return string;
+    }
+
+    // Trims the common prefix and suffix, then runs Myers' O(ND) algorithm on the rest. Returns
+    // false if the sequences need more than MAX_EDIT_DISTANCE insertions and deletions.
+    template <class Equal>
+    static bool diff_sequences(std::int64_t a_size, std::int64_t b_size, Equal&& equal, std::vector<Hunk>& r_hunks)
+    {
+        std::int64_t prefix = 0;
+        while (prefix < a_size && prefix < b_size && equal(prefix, prefix))
+            prefix++;
+        std::int64_t suffix = 0;
+        while (suffix < a_size - prefix && suffix < b_size - prefix && equal(a_size - 1 - suffix, b_size - 1 - suffix))
+            suffix++;
+
+        std::int64_t n = a_size - prefix - suffix;
+        std::int64_t m = b_size - prefix - suffix;
+        if (n == 0 && m == 0)
+            return true;
+        if (std::abs(n - m) > MAX_EDIT_DISTANCE)
+            return false;
+
+        // v[k + offset] is the furthest x reached on diagonal k = x - y, and trace keeps a copy of
+        // v before each step, for walking the edits back
+        std::int64_t max_edits = std::min(n + m, MAX_EDIT_DISTANCE);
+        std::int64_t offset = max_edits + 1;
+        std::vector<std::int64_t> v(2 * offset + 1, 0);
+        std::vector<std::vector<std::int64_t>> trace;
+        std::int64_t edits = -1;
+        for (std::int64_t d = 0; d <= max_edits && edits < 0; ++d)
+        {
+            trace.push_back(v);
+            for (std::int64_t k = -d; k <= d; k += 2)
+            {
+                std::int64_t x;
+                if (k == -d || (k != d && v[k - 1 + offset] < v[k + 1 + offset]))
+                    x = v[k + 1 + offset];
+                else
+                    x = v[k - 1 + offset] + 1;
+                std::int64_t y = x - k;
+                while (x < n && y < m && equal(prefix + x, prefix + y))
+                {
+                    x++;
+                    y++;
+                }
+                v[k + offset] = x;
+                if (x >= n && y >= m)
+                {
+                    edits = d;
+                    break;
+                }
+            }
+        }
+        if (edits < 0)
+            return false;
+
+        // Walks back from (n, m), collecting each edit as the position it was made at
+        struct Edit
+        {
+            bool inserted;
+            std::int64_t x;
+            std::int64_t y;
+        };
+        std::vector<Edit> edit_script(edits);
+        std::int64_t x = n;
+        std::int64_t y = m;
+        for (std::int64_t d = edits; d > 0; --d)
+        {
+            const std::vector<std::int64_t>& previous_v = trace[d];
+            std::int64_t k = x - y;
+            bool inserted = k == -d || (k != d && previous_v[k - 1 + offset] < previous_v[k + 1 + offset]);
+            std::int64_t previous_k = inserted ? k + 1 : k - 1;
+            x = previous_v[previous_k + offset];
+            y = x - previous_k;
+            edit_script[d - 1] = Edit{inserted, x, y};
+        }
+
+        // Merges the edits without equal elements between them into hunks
+        for (const Edit& edit : edit_script)
+        {
+            bool adjacent = !r_hunks.empty() && r_hunks.back().a_start + r_hunks.back().a_count == prefix + edit.x && r_hunks.back().b_start + r_hunks.back().b_count == prefix + edit.y;
+            if (!adjacent)
+                r_hunks.push_back(Hunk{prefix + edit.x, 0, prefix + edit.y, 0});
+            if (edit.inserted)
+                r_hunks.back().b_count++;
+            else
+                r_hunks.back().a_count++;
+        }
+        return true;
+    }
+
+    static void diff_values(const String& path, const Variant& a, const Variant& b, int depth, DiffLines& r_lines);
+
+    template <class Sequence>
+    static String describe_elements(const Sequence& sequence, std::int64_t start, std::int64_t count)
+    {
+        PackedStringArray elements;
+        for (std::int64_t i = start; i < start + std::min(count, MAX_LISTED_ELEMENTS); ++i)
+            elements.push_back(describe_value(sequence[i]));
+        if (count > MAX_LISTED_ELEMENTS)
+            elements.push_back("...");
+        return String(", ").join(elements);
+    }
+
+    template <class Sequence, class Equal>
+    static void diff_sequence_values(const String& path, const Sequence& a, const Sequence& b, int depth, Equal&& equal, DiffLines& r_lines)
+    {
+        std::vector<Hunk> hunks;
+        if (!diff_sequences(a.size(), b.size(), equal, hunks))
+        {
+            // Too different for an edit script, so only says where they start to differ
+            std::int64_t common_size = std::min(a.size(), b.size());
+            std::int64_t first_difference = 0;
+            while (first_difference < common_size && equal(first_difference, first_difference))
+                first_difference++;
+            std::int64_t differing_positions = 0;
+            for (std::int64_t i = first_difference; i < common_size; ++i)
+                differing_positions += equal(i, i) ? 0 : 1;
+
+            r_lines.add(vformat("%s: sizes %s and %s, more than %s insertions and removals apart", describe_path(path), a.size(), b.size(), MAX_EDIT_DISTANCE));
+            r_lines.add(vformat("%s: first difference at [%s], %s of the first %s positions differ", describe_path(path), first_difference, differing_positions, common_size));
+            return;
+        }
+
+        if (a.size() != b.size())
+            r_lines.add(vformat("%s: sizes %s and %s", describe_path(path), a.size(), b.size()));
+
+        for (const Hunk& hunk : hunks)
+        {
+            if (hunk.b_count == 0)
+            {
+                r_lines.add(vformat("%s[%s]: removed %s: %s", path, hunk.a_start, hunk.a_count, describe_elements(a, hunk.a_start, hunk.a_count)));
+            }
+            else if (hunk.a_count == 0)
+            {
+                r_lines.add(vformat("%s[%s]: inserted %s: %s", path, hunk.a_start, hunk.b_count, describe_elements(b, hunk.b_start, hunk.b_count)));
+            }
+            else if (hunk.a_count == hunk.b_count)
+            {
+                // Replaced elements are diffed one by one, so that nested differences show up
+                for (std::int64_t i = 0; i < hunk.a_count && !r_lines.is_full(); ++i)
+                    diff_values(vformat("%s[%s]", path, hunk.a_start + i), a[hunk.a_start + i], b[hunk.b_start + i], depth + 1, r_lines);
+            }
+            else
+            {
+                r_lines.add(vformat("%s[%s]: replaced %s: %s with %s: %s", path, hunk.a_start, hunk.a_count, describe_elements(a, hunk.a_start, hunk.a_count),
+                    hunk.b_count, describe_elements(b, hunk.b_start, hunk.b_count)));
+            }
+        }
+    }
+
+    // The elements of the value-type packed arrays are compared by their bytes, so that NaN
+    // equals itself, like it does in the hashes
+    template <class PackedArray>
+    static void diff_packed_values(const String& path, const PackedArray& a, const PackedArray& b, int depth, DiffLines& r_lines)
+    {
+        auto* a_data = a.ptr();
+        auto* b_data = b.ptr();
+        diff_sequence_values(path, a, b, depth, [&](std::int64_t i, std::int64_t j) { return std::memcmp(&a_data[i], &b_data[j], sizeof(a_data[i])) == 0; }, r_lines);
+    }
+
+    // A hash that is equal for equal values. Variant::hash() is not, since the hash of a
+    // Dictionary depends on the order its keys were inserted in, while == does not, so the pairs
+    // of a dictionary are combined here in a way that does not depend on their order.
+    static std::uint32_t hash_content(const Variant& value, int depth)
+    {
+        switch (value.get_type())
+        {
+            case Variant::ARRAY:
+            {
+                if (depth >= MAX_DIFF_DEPTH)
+                    return Variant::ARRAY;
+                Array array = value;
+                std::uint32_t hash = std::uint32_t(array.size());
+                for (std::int64_t i = 0; i < array.size(); ++i)
+                    hash = hash * 31 + hash_content(array[i], depth + 1);
+                return hash;
+            }
+            case Variant::DICTIONARY:
+            {
+                if (depth >= MAX_DIFF_DEPTH)
+                    return Variant::DICTIONARY;
+                Dictionary dictionary = value;
+                Array keys = dictionary.keys();
+                std::uint32_t hash = std::uint32_t(keys.size());
+                for (std::int64_t i = 0; i < keys.size(); ++i)
+                {
+                    std::uint32_t pair_hash = hash_content(keys[i], depth + 1) * 0x9e3779b1u ^ hash_content(dictionary[keys[i]], depth + 1);
+                    hash += pair_hash * 0x85ebca6bu ^ (pair_hash >> 16);
+                }
+                return hash;
+            }
+            default:
+                return value.hash();
+        }
+    }
+
+    static void diff_array_values(const String& path, const Array& a, const Array& b, int depth, DiffLines& r_lines)
+    {
+        // Hashing each element once makes the comparisons in the diff cheap, and only elements
+        // with equal hashes are compared deeply
+        std::vector<std::uint32_t> a_hashes(a.size());
+        std::vector<std::uint32_t> b_hashes(b.size());
+        for (std::int64_t i = 0; i < a.size(); ++i)
+            a_hashes[i] = hash_content(a[i], 0);
+        for (std::int64_t i = 0; i < b.size(); ++i)
+            b_hashes[i] = hash_content(b[i], 0);
+
+        diff_sequence_values(path, a, b, depth, [&](std::int64_t i, std::int64_t j) { return a_hashes[i] == b_hashes[j] && a[i] == b[j]; }, r_lines);
+    }
+
+    static void diff_dictionary_values(const String& path, const Dictionary& a, const Dictionary& b, int depth, DiffLines& r_lines)
+    {
+        Array a_keys = a.keys();
+        Array b_keys = b.keys();
+
+        PackedStringArray removed_keys;
+        std::int64_t removed_count = 0;
+        Array changed_keys;
+        for (std::int64_t i = 0; i < a_keys.size(); ++i)
+        {
+            const Variant& key = a_keys[i];
+            if (!b.has(key))
+            {
+                if (removed_count++ < MAX_LISTED_ELEMENTS)
+                    removed_keys.push_back(describe_value(key));
+            }
+            else if (!containers_equal(a[key], b[key]))
+            {
+                changed_keys.push_back(key);
+            }
+        }
+
+        PackedStringArray added_keys;
+        std::int64_t added_count = 0;
+        for (std::int64_t i = 0; i < b_keys.size(); ++i)
+        {
+            if (!a.has(b_keys[i]) && added_count++ < MAX_LISTED_ELEMENTS)
+                added_keys.push_back(describe_value(b_keys[i]));
+        }
+
+        if (removed_count > MAX_LISTED_ELEMENTS)
+            removed_keys.push_back("...");
+        if (added_count > MAX_LISTED_ELEMENTS)
+            added_keys.push_back("...");
+
+        if (removed_count > 0)
+            r_lines.add(vformat("%s: %s keys only in EXPR_A: %s", describe_path(path), removed_count, String(", ").join(removed_keys)));
+        if (added_count > 0)
+            r_lines.add(vformat("%s: %s keys only in EXPR_B: %s", describe_path(path), added_count, String(", ").join(added_keys)));
+        for (std::int64_t i = 0; i < changed_keys.size(); ++i)
+            diff_values(vformat("%s[%s]", path, describe_value(changed_keys[i])), a[changed_keys[i]], b[changed_keys[i]], depth + 1, r_lines);
+    }
+
+    static void diff_values(const String& path, const Variant& a, const Variant& b, int depth, DiffLines& r_lines)
+    {
+        Variant::Type type = a.get_type();
+        if (type != b.get_type() || !is_container(type) || depth >= MAX_DIFF_DEPTH)
+        {
+            r_lines.add(vformat("%s: %s vs %s", describe_path(path), describe_value(a), describe_value(b)));
+            return;
+        }
+
+        switch (type)
+        {
+            case Variant::ARRAY:
+                diff_array_values(path, a, b, depth, r_lines);
+                break;
+            case Variant::DICTIONARY:
+                diff_dictionary_values(path, a, b, depth, r_lines);
+                break;
+            case Variant::PACKED_BYTE_ARRAY:
+                diff_packed_values(path, PackedByteArray(a), PackedByteArray(b), depth, r_lines);
+                break;
+            case Variant::PACKED_INT32_ARRAY:
+                diff_packed_values(path, PackedInt32Array(a), PackedInt32Array(b), depth, r_lines);
+                break;
+            case Variant::PACKED_INT64_ARRAY:
+                diff_packed_values(path, PackedInt64Array(a), PackedInt64Array(b), depth, r_lines);
+                break;
+            case Variant::PACKED_FLOAT32_ARRAY:
+                diff_packed_values(path, PackedFloat32Array(a), PackedFloat32Array(b), depth, r_lines);
+                break;
+            case Variant::PACKED_FLOAT64_ARRAY:
+                diff_packed_values(path, PackedFloat64Array(a), PackedFloat64Array(b), depth, r_lines);
+                break;
+            case Variant::PACKED_VECTOR2_ARRAY:
+                diff_packed_values(path, PackedVector2Array(a), PackedVector2Array(b), depth, r_lines);
+                break;
+            case Variant::PACKED_VECTOR3_ARRAY:
+                diff_packed_values(path, PackedVector3Array(a), PackedVector3Array(b), depth, r_lines);
+                break;
+            case Variant::PACKED_COLOR_ARRAY:
+                diff_packed_values(path, PackedColorArray(a), PackedColorArray(b), depth, r_lines);
+                break;
+            case Variant::PACKED_VECTOR4_ARRAY:
+                diff_packed_values(path, PackedVector4Array(a), PackedVector4Array(b), depth, r_lines);
+                break;
+            case Variant::PACKED_STRING_ARRAY:
+            {
+                PackedStringArray a_strings = a;
+                PackedStringArray b_strings = b;
+                diff_sequence_values(path, a_strings, b_strings, depth, [&](std::int64_t i, std::int64_t j) { return a_strings[i] == b_strings[j]; }, r_lines);
+                break;
+            }
+            default:
+                r_lines.add(vformat("%s: %s vs %s", describe_path(path), describe_value(a), describe_value(b)));
+                break;
+        }
+    }
+
+    bool containers_equal(const Variant& a, const Variant& b)
+    {
+        return a.get_type() == b.get_type() && a == b;
+    }
+
+    PackedStringArray diff_containers(const Variant& a, const Variant& b)
+    {
+        DiffLines lines;
+        if (!containers_equal(a, b))
+            diff_values(String(), a, b, 0, lines);
+        return lines.finish();
+    }
+}
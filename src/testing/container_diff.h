@@ -0,0 +1,24 @@
+#ifndef CONTAINER_DIFF_H
+#define CONTAINER_DIFF_H
+
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+namespace godot::Testing
+{
+    // Whether two values are equal and of the same type (dictionaries do not need to have their
+    // keys in the same order)
+    bool containers_equal(const Variant& a, const Variant& b);
+
+    // A compact description of how two values differ, for printing instead of both full values.
+    // Arrays and packed arrays are diffed as sequences (with Myers' algorithm, bounded to
+    // MAX_EDIT_DISTANCE edits), and dictionaries by their key sets. Differing elements that are
+    // containers themselves are diffed in turn, with their path (such as [3]["name"]) in front.
+    // The description is limited to MAX_DIFF_LINES lines.
+    PackedStringArray diff_containers(const Variant& a, const Variant& b);
+
+    static constexpr std::int64_t MAX_EDIT_DISTANCE = 256;
+    static constexpr std::int64_t MAX_DIFF_LINES = 24;
+}
+
+#endif
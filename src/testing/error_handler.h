@@ -4,20 +4,328 @@
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <tuple>
-#include <functional>
+#include <vector>
 
 namespace godot
 {
     class ErrorHandler
     {
     public:
+        enum MessageKind : std::uint8_t
+        {
+            MESSAGE_PRINTERR,
+            MESSAGE_PUSH_ERROR,
+            MESSAGE_PUSH_WARNING,
+            MESSAGE_ANY,
+        };
+
+        // A capture context records the messages reported while it is current. Each thread reports
+        // into its own current context (or the global context if it has none). Appending is
+        // lock-free, so several threads may report into the same context at once.
+        //
+        // Only the most recent messages are retained, in a ring buffer with a fixed capacity, so the
+        // memory used by a context does not grow however many messages are reported. The counts
+        // keep counting every message ever reported. The ring is only allocated once the first
+        // message is reported, since most contexts never see one.
+        //
+        // Messages are stored as their unformatted arguments and are only converted to text when
+        // they are read back with get_last_n(). Objects, containers, and packed arrays are the
+        // exception: they are formatted when the message is reported, since they could change
+        // afterwards, and holding on to them would keep them alive (and show up as leaks).
+        class Context
+        {
+        public:
+            explicit Context(std::int64_t capacity = get_message_capacity()) :
+                m_capacity(std::max<std::int64_t>(capacity, 1))
+            {}
+
+            ~Context()
+            {
+                delete[] m_slots.load(std::memory_order_relaxed);
+            }
+
+            Context(const Context&) = delete;
+            Context& operator=(const Context&) = delete;
+
+            void append(MessageKind kind, const Variant* arguments, int argument_count)
+            {
+                m_message_count.fetch_add(1, std::memory_order_relaxed);
+                m_kind_counts[kind].fetch_add(1, std::memory_order_relaxed);
+
+                Slot* slots = get_or_allocate_slots();
+                if (get_intern_repeats() && intern_repeat(slots, kind, arguments, argument_count))
+                    return;
+
+                std::int64_t index = m_slot_count.fetch_add(1, std::memory_order_relaxed);
+                Slot& slot = slots[index % m_capacity];
+
+                // Only contended if writers have lapped the whole ring while this slot was being written
+                while (slot.writing.test_and_set(std::memory_order_acquire))
+                    ;
+                slot.sequence.store(0, std::memory_order_relaxed);
+                slot.message.kind = kind;
+                slot.message.set_arguments(arguments, argument_count);
+                slot.repeat_count.store(1, std::memory_order_relaxed);
+                slot.sequence.store(index + 1, std::memory_order_release);
+                slot.writing.clear(std::memory_order_release);
+            }
+
+            std::int64_t get_count(MessageKind kind) const
+            {
+                if (kind == MESSAGE_ANY)
+                    return m_message_count.load(std::memory_order_relaxed);
+                return m_kind_counts[kind].load(std::memory_order_relaxed);
+            }
+
+            std::int64_t get_capacity() const
+            {
+                return m_capacity;
+            }
+
+            // Returns (up to) the last n messages of the given kind that are still retained, oldest
+            // first. Messages that are being written by another thread while they are read are
+            // skipped.
+            PackedStringArray get_last_n(std::int64_t n, MessageKind kind) const
+            {
+                PackedStringArray last_n_messages;
+                Slot* slots = m_slots.load(std::memory_order_acquire);
+                if (slots == nullptr)
+                    return last_n_messages;
+                last_n_messages.resize(std::max<std::int64_t>(std::min(n, get_count(kind)), 0));
+
+                std::int64_t slot_count = m_slot_count.load(std::memory_order_acquire);
+                std::int64_t oldest_retained_index = std::max<std::int64_t>(slot_count - m_capacity, 0);
+
+                std::int64_t found = 0;
+                for (std::int64_t i = slot_count - 1; i >= oldest_retained_index && found < last_n_messages.size(); --i)
+                {
+                    // The message is copied while holding the slot, so that a writer lapping the
+                    // ring cannot replace its arguments while they are read. Formatting happens
+                    // after the slot is released.
+                    Slot& slot = slots[i % m_capacity];
+                    if (slot.writing.test_and_set(std::memory_order_acquire))
+                        continue;
+                    bool current = slot.sequence.load(std::memory_order_acquire) == std::uint64_t(i + 1) &&
+                        (kind == MESSAGE_ANY || slot.message.kind == kind);
+                    Message message;
+                    std::int64_t repeat_count = 0;
+                    if (current)
+                    {
+                        message = slot.message;
+                        repeat_count = slot.repeat_count.load(std::memory_order_relaxed);
+                    }
+                    slot.writing.clear(std::memory_order_release);
+                    if (!current)
+                        continue;
+
+                    String text = message.format();
+                    for (std::int64_t j = 0; j < repeat_count && found < last_n_messages.size(); ++j)
+                    {
+                        last_n_messages[last_n_messages.size() - 1 - found] = text;
+                        found++;
+                    }
+                }
+
+                if (found < last_n_messages.size())
+                    last_n_messages = last_n_messages.slice(last_n_messages.size() - found);
+                return last_n_messages;
+            }
+
+        private:
+            static constexpr int MAX_INLINE_ARGUMENTS = 4;
+
+            struct Message
+            {
+                MessageKind kind = MESSAGE_PRINTERR;
+                int argument_count = 0;
+                Variant arguments[MAX_INLINE_ARGUMENTS];
+                // Only allocated for the rare message with more arguments than fit inline
+                std::vector<Variant> extra_arguments;
+
+                const Variant& get_argument(int index) const
+                {
+                    return index < MAX_INLINE_ARGUMENTS ? arguments[index] : extra_arguments[index - MAX_INLINE_ARGUMENTS];
+                }
+
+                // Value types are kept as they are, and anything that refers to shared data is
+                // formatted right away
+                static Variant freeze(const Variant& argument)
+                {
+                    if (argument.get_type() < Variant::OBJECT)
+                        return argument;
+                    return UtilityFunctions::str(argument);
+                }
+
+                void set_arguments(const Variant* p_arguments, int p_argument_count)
+                {
+                    argument_count = p_argument_count;
+                    for (int i = 0; i < MAX_INLINE_ARGUMENTS; ++i)
+                        arguments[i] = i < p_argument_count ? freeze(p_arguments[i]) : Variant();
+                    extra_arguments.clear();
+                    for (int i = MAX_INLINE_ARGUMENTS; i < p_argument_count; ++i)
+                        extra_arguments.push_back(freeze(p_arguments[i]));
+                }
+
+                bool has_arguments(const Variant* p_arguments, int p_argument_count) const
+                {
+                    if (argument_count != p_argument_count)
+                        return false;
+                    for (int i = 0; i < p_argument_count; ++i)
+                    {
+                        const Variant& argument = get_argument(i);
+                        Variant frozen_argument = freeze(p_arguments[i]);
+                        if (argument.get_type() != frozen_argument.get_type() || argument != frozen_argument)
+                            return false;
+                    }
+                    return true;
+                }
+
+                // Formats the arguments the same way UtilityFunctions::str() does
+                String format() const
+                {
+                    String message;
+                    for (int i = 0; i < argument_count; ++i)
+                        message += UtilityFunctions::str(get_argument(i));
+                    return message;
+                }
+            };
+
+            struct Slot
+            {
+                std::atomic<std::uint64_t> sequence = 0;
+                std::atomic_flag writing = ATOMIC_FLAG_INIT;
+                std::atomic<std::int64_t> repeat_count = 0;
+                Message message;
+            };
+
+            Slot* get_or_allocate_slots()
+            {
+                Slot* slots = m_slots.load(std::memory_order_acquire);
+                if (slots != nullptr)
+                    return slots;
+
+                // Threads reporting the first message at the same time race to install their ring
+                Slot* new_slots = new Slot[m_capacity];
+                if (m_slots.compare_exchange_strong(slots, new_slots, std::memory_order_acq_rel, std::memory_order_acquire))
+                    return new_slots;
+                delete[] new_slots;
+                return slots;
+            }
+
+            // Adds one to the repeat count of the newest message if it is identical to this one
+            bool intern_repeat(Slot* slots, MessageKind kind, const Variant* arguments, int argument_count)
+            {
+                std::int64_t newest_index = m_slot_count.load(std::memory_order_acquire) - 1;
+                if (newest_index < 0)
+                    return false;
+
+                Slot& slot = slots[newest_index % m_capacity];
+                if (slot.writing.test_and_set(std::memory_order_acquire))
+                    return false;
+                bool interned = slot.sequence.load(std::memory_order_acquire) == std::uint64_t(newest_index + 1) &&
+                    slot.message.kind == kind && slot.message.has_arguments(arguments, argument_count);
+                if (interned)
+                    slot.repeat_count.fetch_add(1, std::memory_order_relaxed);
+                slot.writing.clear(std::memory_order_release);
+                return interned;
+            }
+
+            const std::int64_t m_capacity;
+            std::atomic<Slot*> m_slots = nullptr;
+
+            std::atomic<std::int64_t> m_slot_count = 0;
+            std::atomic<std::int64_t> m_message_count = 0;
+            std::atomic<std::int64_t> m_kind_counts[MESSAGE_ANY] = {};
+        };
+
+        // Makes a new context current on this thread for as long as it exists.
+        class ScopedContext
+        {
+        public:
+            ScopedContext() : m_previous_context(t_current_context)
+            {
+                t_current_context = &m_context;
+            }
+
+            ~ScopedContext()
+            {
+                t_current_context = m_previous_context;
+            }
+
+            Context& get_context()
+            {
+                return m_context;
+            }
+
+        private:
+            Context m_context;
+            Context* m_previous_context;
+        };
+
+        // Makes an existing context current on this thread for as long as it exists. Use this in
+        // worker threads so that their errors are counted by the test that started them.
+        class ScopedAttach
+        {
+        public:
+            explicit ScopedAttach(Context& context) : m_previous_context(t_current_context)
+            {
+                t_current_context = &context;
+            }
+
+            ~ScopedAttach()
+            {
+                t_current_context = m_previous_context;
+            }
+
+        private:
+            Context* m_previous_context;
+        };
+
+        static Context& get_current_context()
+        {
+            return t_current_context != nullptr ? *t_current_context : get_global_context();
+        }
+
+        // The global context is created the first time it is used, so set the capacity before
+        // reporting any messages for it to apply to the global context as well.
+        static Context& get_global_context()
+        {
+            static Context global_context;
+            return global_context;
+        }
+
+        static std::int64_t get_message_capacity()
+        {
+            return s_message_capacity.load(std::memory_order_relaxed);
+        }
+
+        static bool get_intern_repeats()
+        {
+            return s_intern_repeats.load(std::memory_order_relaxed);
+        }
+
+        // If enabled, a message identical to the one reported just before it is stored by adding
+        // to the repeat count of that message instead of taking up a new entry
+        static void set_intern_repeats(bool intern_repeats)
+        {
+            s_intern_repeats.store(intern_repeats, std::memory_order_relaxed);
+        }
+
+        // Sets how many messages each context created from now on retains
+        static void set_message_capacity(std::int64_t message_capacity)
+        {
+            s_message_capacity.store(message_capacity, std::memory_order_relaxed);
+        }
+
         template <typename... Args>
         static void printerr(const Variant &p_arg1, const Args &...p_args)
         {
-            m_printerr_message_indexes.push_back(m_messages.size());
-            m_messages.push_back(UtilityFunctions::str(p_arg1, p_args...));
+            const Variant arguments[] = {p_arg1, Variant(p_args)...};
+            get_current_context().append(MESSAGE_PRINTERR, arguments, 1 + sizeof...(p_args));
 
             if (!suppress_printerr)
                 UtilityFunctions::printerr(p_arg1, p_args...);
@@ -26,8 +334,8 @@ namespace godot
         template <typename... Args>
         static void push_error(const Variant &p_arg1, const Args &...p_args)
         {
-            m_push_error_message_indexes.push_back(m_messages.size());
-            m_messages.push_back(UtilityFunctions::str(p_arg1, p_args...));
+            const Variant arguments[] = {p_arg1, Variant(p_args)...};
+            get_current_context().append(MESSAGE_PUSH_ERROR, arguments, 1 + sizeof...(p_args));
 
             if (!suppress_push_error)
                 UtilityFunctions::push_error(p_arg1, p_args...);
@@ -36,31 +344,31 @@ namespace godot
         template <typename... Args>
         static void push_warning(const Variant &p_arg1, const Args &...p_args)
         {
-            m_push_warning_message_indexes.push_back(m_messages.size());
-            m_messages.push_back(UtilityFunctions::str(p_arg1, p_args...));
+            const Variant arguments[] = {p_arg1, Variant(p_args)...};
+            get_current_context().append(MESSAGE_PUSH_WARNING, arguments, 1 + sizeof...(p_args));
 
             if (!suppress_push_warning)
                 UtilityFunctions::push_warning(p_arg1, p_args...);
         }
 
-        static int get_total_count()
+        static std::int64_t get_total_count()
         {
-            return m_messages.size();
+            return get_current_context().get_count(MESSAGE_ANY);
         }
 
-        static int get_printerr_count()
+        static std::int64_t get_printerr_count()
         {
-            return m_printerr_message_indexes.size();
+            return get_current_context().get_count(MESSAGE_PRINTERR);
         }
 
-        static int get_push_error_count()
+        static std::int64_t get_push_error_count()
         {
-            return m_push_error_message_indexes.size();
+            return get_current_context().get_count(MESSAGE_PUSH_ERROR);
         }
 
-        static int get_push_warning_count()
+        static std::int64_t get_push_warning_count()
         {
-            return m_push_warning_message_indexes.size();
+            return get_current_context().get_count(MESSAGE_PUSH_WARNING);
         }
 
         static void set_suppress_all(std::tuple<bool, bool, bool> suppress)
@@ -77,61 +385,33 @@ namespace godot
 
         static PackedStringArray get_last_n_errors(std::int64_t n)
         {
-            return get_last_n_messages_helper(n, m_messages.size(),
-                [&](std::int64_t i) -> String {return m_messages[i];});
+            return get_current_context().get_last_n(n, MESSAGE_ANY);
         }
 
         static PackedStringArray get_last_n_printerrs(std::int64_t n)
         {
-            return get_last_n_messages_helper(n, m_printerr_message_indexes.size(),
-                [&](std::int64_t i) -> String {return m_messages[m_printerr_message_indexes[i]];});
+            return get_current_context().get_last_n(n, MESSAGE_PRINTERR);
         }
 
         static PackedStringArray get_last_n_push_errors(std::int64_t n)
         {
-            return get_last_n_messages_helper(n, m_push_error_message_indexes.size(),
-                [&](std::int64_t i) -> String {return m_messages[m_push_error_message_indexes[i]];});
+            return get_current_context().get_last_n(n, MESSAGE_PUSH_ERROR);
         }
 
         static PackedStringArray get_last_n_push_warnings(std::int64_t n)
         {
-            return get_last_n_messages_helper(n, m_push_warning_message_indexes.size(),
-                [&](std::int64_t i) -> String {return m_messages[m_push_warning_message_indexes[i]];});
+            return get_current_context().get_last_n(n, MESSAGE_PUSH_WARNING);
         }
 
-        static inline bool suppress_printerr = false;
-        static inline bool suppress_push_error = false;
-        static inline bool suppress_push_warning = false;
+        // Suppression is per thread
+        static inline thread_local bool suppress_printerr = false;
+        static inline thread_local bool suppress_push_error = false;
+        static inline thread_local bool suppress_push_warning = false;
 
     private:
-        static PackedStringArray get_last_n_messages_helper(std::int64_t n, std::int64_t message_count, std::function<String (std::int64_t i)> get_message)
-        {
-            PackedStringArray last_n_messages;
-            std::int64_t messages_start_index;
-            std::int64_t last_n_messages_size;
-
-            if (message_count < n)
-            {
-                last_n_messages_size = message_count;
-                messages_start_index = 0;
-            }
-            else
-            {
-                last_n_messages_size = n;
-                messages_start_index = message_count - n;
-            }
-
-            last_n_messages.resize(last_n_messages_size);
-            for (std::int64_t i = 0; i < last_n_messages_size; ++i)
-                last_n_messages[i] = get_message(i + messages_start_index);
-
-            return last_n_messages;
-        }
-
-        static inline std::vector<String> m_messages = {};
-        static inline std::vector<std::int64_t> m_printerr_message_indexes = {};
-        static inline std::vector<std::int64_t> m_push_error_message_indexes = {};
-        static inline std::vector<std::int64_t> m_push_warning_message_indexes = {};
+        static inline std::atomic<std::int64_t> s_message_capacity = 1024;
+        static inline std::atomic<bool> s_intern_repeats = false;
+        static inline thread_local Context* t_current_context = nullptr;
     };
 }
 
@@ -164,7 +444,7 @@ namespace godot
         bool previous_suppress_push_warning = ErrorHandler::suppress_push_warning; \
         ErrorHandler::suppress_push_warning = true; \
         EXPR; \
-        ErrorHandler::suppress_push_warning = previous_suppress_push_warning \
+        ErrorHandler::suppress_push_warning = previous_suppress_push_warning; \
     }
 
 #define COUNT_ALL_ERRORS(EXPR, count) \
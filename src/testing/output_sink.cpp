@@ -0,0 +1,133 @@
+#include "testing/output_sink.h"
+
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+namespace godot::Testing
+{
+    OutputSink::OutputSink()
+    {
+        // Headless runs (such as on a build server) have no use for BBCode
+        DisplayServer* display_server = DisplayServer::get_singleton();
+        m_plain_text = display_server != nullptr && display_server->get_name() == "headless";
+        m_last_flush_usec = Time::get_singleton()->get_ticks_usec();
+    }
+
+    void OutputSink::print_line(const String& line)
+    {
+        m_lines.push_back(m_plain_text ? strip_bbcode(line) : line);
+
+        if (m_flush_line_count > 0 && std::int64_t(m_lines.size()) >= m_flush_line_count)
+            flush();
+        else if (m_flush_interval_usec > 0 && Time::get_singleton()->get_ticks_usec() - m_last_flush_usec >= std::uint64_t(m_flush_interval_usec))
+            flush();
+    }
+
+    void OutputSink::flush()
+    {
+        m_last_flush_usec = Time::get_singleton()->get_ticks_usec();
+        if (m_lines.empty())
+            return;
+
+        std::int64_t length = 0;
+        for (const String& line : m_lines)
+            length += line.length() + 1;
+
+        String text;
+        text.resize(length);
+        char32_t* text_ptr = text.ptrw();
+        for (const String& line : m_lines)
+        {
+            const char32_t* line_ptr = line.ptr();
+            for (std::int64_t i = 0; i < line.length(); ++i)
+                *text_ptr++ = line_ptr[i];
+            *text_ptr++ = '\n';
+        }
+        // Replace the final newline with the terminating null character
+        *(text_ptr - 1) = 0;
+
+        m_lines.clear();
+        write(text);
+    }
+
+    void OutputSink::forward_to(const Ref<OutputSink>& output_sink)
+    {
+        for (const String& line : m_lines)
+            output_sink->print_line(line);
+        m_lines.clear();
+    }
+
+    void OutputSink::write(const String& text)
+    {
+        if (m_plain_text)
+            UtilityFunctions::print(text);
+        else
+            UtilityFunctions::print_rich(text);
+    }
+
+    bool OutputSink::get_plain_text() const
+    {
+        return m_plain_text;
+    }
+
+    void OutputSink::set_plain_text(bool plain_text)
+    {
+        m_plain_text = plain_text;
+    }
+
+    std::int64_t OutputSink::get_flush_line_count() const
+    {
+        return m_flush_line_count;
+    }
+
+    void OutputSink::set_flush_line_count(std::int64_t flush_line_count)
+    {
+        m_flush_line_count = flush_line_count;
+    }
+
+    std::int64_t OutputSink::get_flush_interval_usec() const
+    {
+        return m_flush_interval_usec;
+    }
+
+    void OutputSink::set_flush_interval_usec(std::int64_t flush_interval_usec)
+    {
+        m_flush_interval_usec = flush_interval_usec;
+    }
+
+    String strip_bbcode(const String& text)
+    {
+        String stripped = text.replace("[b]", "").replace("[/b]", "").replace("[/color]", "");
+
+        std::int64_t tag_start = stripped.find("[color=");
+        while (tag_start >= 0)
+        {
+            std::int64_t tag_end = stripped.find("]", tag_start);
+            if (tag_end < 0)
+                break;
+            stripped = stripped.substr(0, tag_start) + stripped.substr(tag_end + 1);
+            tag_start = stripped.find("[color=", tag_start);
+        }
+
+        return stripped;
+    }
+
+    void OutputSink::_bind_methods()
+    {
+        ClassDB::bind_method(D_METHOD("print_line", "line"), &OutputSink::print_line);
+        ClassDB::bind_method(D_METHOD("flush"), &OutputSink::flush);
+
+        ClassDB::bind_method(D_METHOD("get_plain_text"), &OutputSink::get_plain_text);
+        ClassDB::bind_method(D_METHOD("set_plain_text", "plain_text"), &OutputSink::set_plain_text);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "plain_text"), "set_plain_text", "get_plain_text");
+
+        ClassDB::bind_method(D_METHOD("get_flush_line_count"), &OutputSink::get_flush_line_count);
+        ClassDB::bind_method(D_METHOD("set_flush_line_count", "flush_line_count"), &OutputSink::set_flush_line_count);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "flush_line_count"), "set_flush_line_count", "get_flush_line_count");
+
+        ClassDB::bind_method(D_METHOD("get_flush_interval_usec"), &OutputSink::get_flush_interval_usec);
+        ClassDB::bind_method(D_METHOD("set_flush_interval_usec", "flush_interval_usec"), &OutputSink::set_flush_interval_usec);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "flush_interval_usec", PROPERTY_HINT_NONE, "suffix:us"), "set_flush_interval_usec", "get_flush_interval_usec");
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+
+#include <vector>
+
+namespace godot::Testing
+{
+    // Collects the lines of a test report and writes them out in batches. By default, the lines
+    // are written to the console with print_rich(), or with print() and without BBCode if plain
+    // text is enabled. Subclasses can override write() to send the report somewhere else.
+    class OutputSink : public RefCounted
+    {
+        GDCLASS(OutputSink, RefCounted)
+
+    public:
+        OutputSink();
+
+        void print_line(const String& line);
+        void flush();
+
+        // Moves all buffered lines into another sink without writing them
+        void forward_to(const Ref<OutputSink>& output_sink);
+
+        bool get_plain_text() const;
+        void set_plain_text(bool plain_text);
+
+        std::int64_t get_flush_line_count() const;
+        void set_flush_line_count(std::int64_t flush_line_count);
+
+        std::int64_t get_flush_interval_usec() const;
+        void set_flush_interval_usec(std::int64_t flush_interval_usec);
+
+    protected:
+        static void _bind_methods();
+
+        virtual void write(const String& text);
+
+        // Kept between flushes so that its capacity is reused
+        std::vector<String> m_lines;
+
+        bool m_plain_text = false;
+
+        // Zero disables the corresponding automatic flush
+        std::int64_t m_flush_line_count = 0;
+        std::int64_t m_flush_interval_usec = 1000000;
+
+        std::uint64_t m_last_flush_usec = 0;
+    };
+
+    // Removes the BBCode tags used by the test report
+    String strip_bbcode(const String& text);
+}
+
+#endif
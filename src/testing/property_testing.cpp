@@ -0,0 +1,364 @@
+#include "testing/property_testing.h"
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace godot::Testing::Generate
+{
+    // Containers in generated variants stay small, since they nest
+    static constexpr std::int64_t MAX_VARIANT_CONTAINER_SIZE = 8;
+    // Long values only get this many candidates that remove or simplify one element each
+    static constexpr std::int64_t MAX_ELEMENT_CANDIDATES = 16;
+
+    // The candidates that move an integer towards a target, halving the distance each time
+    static std::vector<std::int64_t> shrink_towards(std::int64_t value, std::int64_t target)
+    {
+        std::vector<std::int64_t> candidates;
+        if (value == target)
+            return candidates;
+        candidates.push_back(target);
+        for (std::int64_t distance = (value - target) / 2; distance != 0; distance /= 2)
+            candidates.push_back(value - distance);
+        if (candidates.back() != value - (value > target ? 1 : -1))
+            candidates.push_back(value - (value > target ? 1 : -1));
+        return candidates;
+    }
+
+    static std::vector<double> shrink_real(double value, double min, double max)
+    {
+        std::vector<double> candidates;
+        double target = std::clamp(0.0, min, max);
+        if (value == target || std::isnan(value))
+            return candidates;
+        candidates.push_back(target);
+        if (std::trunc(value) != value)
+            candidates.push_back(std::trunc(value));
+        double halfway = target + (value - target) / 2.0;
+        if (halfway != value && halfway != target)
+            candidates.push_back(halfway);
+        return candidates;
+    }
+
+    std::int64_t Integers::generate(PropertyRandom& random, std::int64_t size) const
+    {
+        // Small values first, since they find most bugs and shrink quickly
+        if (random.next_bool())
+            return random.next_integer(std::clamp(-size, min, max), std::clamp(size, min, max));
+        return random.next_integer(min, max);
+    }
+
+    std::vector<std::int64_t> Integers::shrink(std::int64_t value) const
+    {
+        return shrink_towards(value, std::clamp<std::int64_t>(0, min, max));
+    }
+
+    double Floats::generate(PropertyRandom& random, std::int64_t size) const
+    {
+        // Edge cases now and then
+        switch (random.next_integer(0, 15))
+        {
+            case 0:
+                return min;
+            case 1:
+                return max;
+            case 2:
+                return std::clamp(0.0, min, max);
+            case 3:
+                return std::clamp(random.next_double(-1.0, 1.0) * 1e-6, min, max);
+            default:
+                return random.next_double(min, max);
+        }
+    }
+
+    std::vector<double> Floats::shrink(double value) const
+    {
+        return shrink_real(value, min, max);
+    }
+
+    bool Booleans::generate(PropertyRandom& random, std::int64_t size) const
+    {
+        return random.next_bool();
+    }
+
+    std::vector<bool> Booleans::shrink(bool value) const
+    {
+        return value ? std::vector<bool>{false} : std::vector<bool>();
+    }
+
+    String Strings::generate(PropertyRandom& random, std::int64_t size) const
+    {
+        static const char32_t ALPHANUMERIC[] = U"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+        // Space, punctuation, accented Latin, Greek, CJK, an emoji, and a combining accent
+        static const char32_t SPECIAL[] = U" \t\n.,;\"'\\/\u00e9\u00fc\u03a9\u4e2d\u6587\U0001F600\u0301";
+
+        std::int64_t length = random.next_integer(0, std::min(size, max_length));
+        String string;
+        string.resize(length + 1);
+        char32_t* characters = string.ptrw();
+        for (std::int64_t i = 0; i < length; ++i)
+        {
+            if (unicode && random.next_integer(0, 3) == 0)
+                characters[i] = SPECIAL[random.next_integer(0, std::size(SPECIAL) - 2)];
+            else
+                characters[i] = ALPHANUMERIC[random.next_integer(0, std::size(ALPHANUMERIC) - 2)];
+        }
+        characters[length] = 0;
+        return string;
+    }
+
+    std::vector<String> Strings::shrink(const String& value) const
+    {
+        std::vector<String> candidates;
+        std::int64_t length = value.length();
+        if (length == 0)
+            return candidates;
+
+        candidates.push_back(String());
+        if (length > 1)
+        {
+            candidates.push_back(value.substr(0, length / 2));
+            candidates.push_back(value.substr(length / 2));
+        }
+        for (std::int64_t i = 0; i < std::min(length, MAX_ELEMENT_CANDIDATES); ++i)
+            candidates.push_back(value.substr(0, i) + value.substr(i + 1));
+        for (std::int64_t i = 0; i < std::min(length, MAX_ELEMENT_CANDIDATES); ++i)
+        {
+            if (value[i] != 'a')
+                candidates.push_back(value.substr(0, i) + "a" + value.substr(i + 1));
+        }
+        return candidates;
+    }
+
+    Vector3 Vector3s::generate(PropertyRandom& random, std::int64_t size) const
+    {
+        // Drawn one at a time, since the order in which function arguments are evaluated is
+        // unspecified, and a seed must give the same values with every compiler
+        Floats components{-range, range};
+        double x = components.generate(random, size);
+        double y = components.generate(random, size);
+        double z = components.generate(random, size);
+        return Vector3(x, y, z);
+    }
+
+    std::vector<Vector3> Vector3s::shrink(const Vector3& value) const
+    {
+        std::vector<Vector3> candidates;
+        if (value != Vector3())
+            candidates.push_back(Vector3());
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            for (double component : shrink_real(value[axis], -range, range))
+            {
+                Vector3 candidate = value;
+                candidate[axis] = component;
+                if (candidate != Vector3())
+                    candidates.push_back(candidate);
+            }
+        }
+        return candidates;
+    }
+
+    Transform3D Transform3Ds::generate(PropertyRandom& random, std::int64_t size) const
+    {
+        // A random rotation (from a uniformly distributed quaternion) with a random positive scale
+        double u1 = random.next_unit();
+        double u2 = random.next_unit() * Math_TAU;
+        double u3 = random.next_unit() * Math_TAU;
+        Quaternion rotation(std::sqrt(1.0 - u1) * std::sin(u2), std::sqrt(1.0 - u1) * std::cos(u2), std::sqrt(u1) * std::sin(u3), std::sqrt(u1) * std::cos(u3));
+        double scale_x = random.next_double(0.1, max_scale);
+        double scale_y = random.next_double(0.1, max_scale);
+        double scale_z = random.next_double(0.1, max_scale);
+        Vector3 scale(scale_x, scale_y, scale_z);
+
+        Basis basis;
+        basis.set_quaternion_scale(rotation, scale);
+        return Transform3D(basis, Vector3s{range}.generate(random, size));
+    }
+
+    std::vector<Transform3D> Transform3Ds::shrink(const Transform3D& value) const
+    {
+        std::vector<Transform3D> candidates;
+        if (value == Transform3D())
+            return candidates;
+
+        candidates.push_back(Transform3D());
+        if (value.basis != Basis())
+            candidates.push_back(Transform3D(Basis(), value.origin));
+        if (value.basis.get_scale() != Vector3(1, 1, 1))
+            candidates.push_back(Transform3D(value.basis.orthonormalized(), value.origin));
+        for (const Vector3& origin : Vector3s{range}.shrink(value.origin))
+            candidates.push_back(Transform3D(value.basis, origin));
+        return candidates;
+    }
+
+    PackedByteArray PackedByteArrays::generate(PropertyRandom& random, std::int64_t size) const
+    {
+        PackedByteArray bytes;
+        bytes.resize(random.next_integer(0, std::min(size, max_size)));
+        std::uint8_t* data = bytes.ptrw();
+        for (std::int64_t i = 0; i < bytes.size(); ++i)
+            data[i] = std::uint8_t(random.next());
+        return bytes;
+    }
+
+    std::vector<PackedByteArray> PackedByteArrays::shrink(const PackedByteArray& value) const
+    {
+        std::vector<PackedByteArray> candidates;
+        std::int64_t size = value.size();
+        if (size == 0)
+            return candidates;
+
+        candidates.push_back(PackedByteArray());
+        if (size > 1)
+        {
+            candidates.push_back(value.slice(0, size / 2));
+            candidates.push_back(value.slice(size / 2));
+        }
+        for (std::int64_t i = 0; i < std::min(size, MAX_ELEMENT_CANDIDATES); ++i)
+        {
+            PackedByteArray candidate = value;
+            candidate.remove_at(i);
+            candidates.push_back(candidate);
+        }
+        for (std::int64_t i = 0; i < std::min(size, MAX_ELEMENT_CANDIDATES); ++i)
+        {
+            if (value[i] == 0)
+                continue;
+            PackedByteArray candidate = value;
+            candidate.set(i, 0);
+            candidates.push_back(candidate);
+        }
+        return candidates;
+    }
+
+    Variant Variants::generate(PropertyRandom& random, std::int64_t size) const
+    {
+        return generate_at_depth(random, size, 0);
+    }
+
+    Variant Variants::generate_at_depth(PropertyRandom& random, std::int64_t size, std::int64_t depth) const
+    {
+        std::int64_t kinds = depth < max_depth ? 8 : 6;
+        switch (random.next_integer(0, kinds - 1))
+        {
+            case 0:
+                return Variant();
+            case 1:
+                return Booleans().generate(random, size);
+            case 2:
+                return Integers().generate(random, size);
+            case 3:
+                return Floats().generate(random, size);
+            case 4:
+                return Strings{16, true}.generate(random, size);
+            case 5:
+                return Vector3s().generate(random, size);
+            case 6:
+            {
+                Array array;
+                std::int64_t array_size = random.next_integer(0, std::min(size, MAX_VARIANT_CONTAINER_SIZE));
+                for (std::int64_t i = 0; i < array_size; ++i)
+                    array.push_back(generate_at_depth(random, size, depth + 1));
+                return array;
+            }
+            default:
+            {
+                Dictionary dictionary;
+                std::int64_t dictionary_size = random.next_integer(0, std::min(size, MAX_VARIANT_CONTAINER_SIZE));
+                for (std::int64_t i = 0; i < dictionary_size; ++i)
+                {
+                    String key = Strings{8, false}.generate(random, size);
+                    dictionary[key] = generate_at_depth(random, size, depth + 1);
+                }
+                return dictionary;
+            }
+        }
+    }
+
+    std::vector<Variant> Variants::shrink(const Variant& value) const
+    {
+        std::vector<Variant> candidates;
+        switch (value.get_type())
+        {
+            case Variant::NIL:
+                return candidates;
+            case Variant::BOOL:
+                for (bool candidate : Booleans().shrink(value))
+                    candidates.push_back(candidate);
+                break;
+            case Variant::INT:
+                for (std::int64_t candidate : shrink_towards(value, 0))
+                    candidates.push_back(candidate);
+                break;
+            case Variant::FLOAT:
+                for (double candidate : shrink_real(value, -INFINITY, INFINITY))
+                    candidates.push_back(candidate);
+                break;
+            case Variant::STRING:
+                for (const String& candidate : Strings().shrink(value))
+                    candidates.push_back(candidate);
+                break;
+            case Variant::VECTOR3:
+                for (const Vector3& candidate : Vector3s().shrink(value))
+                    candidates.push_back(candidate);
+                break;
+            case Variant::ARRAY:
+            {
+                // An element on its own, then the array without one of its elements, then the
+                // array with one element shrunk
+                Array array = value;
+                for (std::int64_t i = 0; i < array.size(); ++i)
+                    candidates.push_back(array[i]);
+                for (std::int64_t i = 0; i < array.size(); ++i)
+                {
+                    Array candidate = array.duplicate();
+                    candidate.remove_at(i);
+                    candidates.push_back(candidate);
+                }
+                for (std::int64_t i = 0; i < array.size(); ++i)
+                {
+                    for (const Variant& element : shrink(array[i]))
+                    {
+                        Array candidate = array.duplicate();
+                        candidate[i] = element;
+                        candidates.push_back(candidate);
+                    }
+                }
+                break;
+            }
+            case Variant::DICTIONARY:
+            {
+                Dictionary dictionary = value;
+                Array keys = dictionary.keys();
+                for (std::int64_t i = 0; i < keys.size(); ++i)
+                    candidates.push_back(dictionary[keys[i]]);
+                for (std::int64_t i = 0; i < keys.size(); ++i)
+                {
+                    Dictionary candidate = dictionary.duplicate();
+                    candidate.erase(keys[i]);
+                    candidates.push_back(candidate);
+                }
+                for (std::int64_t i = 0; i < keys.size(); ++i)
+                {
+                    for (const Variant& element : shrink(dictionary[keys[i]]))
+                    {
+                        Dictionary candidate = dictionary.duplicate();
+                        candidate[keys[i]] = element;
+                        candidates.push_back(candidate);
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        // Anything else can still become null
+        candidates.insert(candidates.begin(), Variant());
+        return candidates;
+    }
+}
@@ -0,0 +1,293 @@
+#ifndef PROPERTY_TESTING_H
+#define PROPERTY_TESTING_H
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/variant/variant.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "testing/error_handler.h"
+
+namespace godot::Testing
+{
+    // A splitmix64 generator: fast, tiny, and fully determined by its seed
+    class PropertyRandom
+    {
+    public:
+        explicit PropertyRandom(std::uint64_t seed) : m_state(seed) {}
+
+        std::uint64_t next()
+        {
+            std::uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+
+        // Uniform in [min, max]
+        std::int64_t next_integer(std::int64_t min, std::int64_t max)
+        {
+            std::uint64_t range = std::uint64_t(max) - std::uint64_t(min) + 1;
+            return range == 0 ? std::int64_t(next()) : std::int64_t(std::uint64_t(min) + next() % range);
+        }
+
+        // Uniform in [0, 1)
+        double next_unit()
+        {
+            return double(next() >> 11) * 0x1.0p-53;
+        }
+
+        double next_double(double min, double max)
+        {
+            return min + (max - min) * next_unit();
+        }
+
+        bool next_bool()
+        {
+            return (next() & 1) != 0;
+        }
+
+        // Mixes a seed with a value, such as the index of a case, into a new seed
+        static std::uint64_t mix(std::uint64_t seed, std::uint64_t value)
+        {
+            return PropertyRandom(seed ^ (value * 0x9e3779b97f4a7c15ULL)).next();
+        }
+
+    private:
+        std::uint64_t m_state;
+    };
+
+    // Generators make random values of one type, and suggest simpler values to shrink a failing
+    // value towards. Each has a Value type, generate(random, size), where size grows from 1 to
+    // the maximum size over the cases of a property, and shrink(value), which lists candidates
+    // from the simplest.
+    namespace Generate
+    {
+        struct Integers
+        {
+            using Value = std::int64_t;
+
+            std::int64_t min = -1000;
+            std::int64_t max = 1000;
+
+            std::int64_t generate(PropertyRandom& random, std::int64_t size) const;
+            std::vector<std::int64_t> shrink(std::int64_t value) const;
+        };
+
+        struct Floats
+        {
+            using Value = double;
+
+            double min = -1000.0;
+            double max = 1000.0;
+
+            double generate(PropertyRandom& random, std::int64_t size) const;
+            std::vector<double> shrink(double value) const;
+        };
+
+        struct Booleans
+        {
+            using Value = bool;
+
+            bool generate(PropertyRandom& random, std::int64_t size) const;
+            std::vector<bool> shrink(bool value) const;
+        };
+
+        struct Strings
+        {
+            using Value = String;
+
+            std::int64_t max_length = 64;
+            // Only ASCII letters and digits if disabled
+            bool unicode = true;
+
+            String generate(PropertyRandom& random, std::int64_t size) const;
+            std::vector<String> shrink(const String& value) const;
+        };
+
+        struct Vector3s
+        {
+            using Value = Vector3;
+
+            real_t range = 1000.0;
+
+            Vector3 generate(PropertyRandom& random, std::int64_t size) const;
+            std::vector<Vector3> shrink(const Vector3& value) const;
+        };
+
+        struct Transform3Ds
+        {
+            using Value = Transform3D;
+
+            real_t range = 1000.0;
+            real_t max_scale = 10.0;
+
+            Transform3D generate(PropertyRandom& random, std::int64_t size) const;
+            std::vector<Transform3D> shrink(const Transform3D& value) const;
+        };
+
+        struct PackedByteArrays
+        {
+            using Value = PackedByteArray;
+
+            std::int64_t max_size = 256;
+
+            PackedByteArray generate(PropertyRandom& random, std::int64_t size) const;
+            std::vector<PackedByteArray> shrink(const PackedByteArray& value) const;
+        };
+
+        // Nulls, booleans, integers, floats, strings, vectors, and arrays and dictionaries of
+        // these, nested up to max_depth levels
+        struct Variants
+        {
+            using Value = Variant;
+
+            std::int64_t max_depth = 3;
+
+            Variant generate(PropertyRandom& random, std::int64_t size) const;
+            std::vector<Variant> shrink(const Variant& value) const;
+
+        private:
+            Variant generate_at_depth(PropertyRandom& random, std::int64_t size, std::int64_t depth) const;
+        };
+
+        inline Integers integers(std::int64_t min = -1000, std::int64_t max = 1000) { return Integers{min, max}; }
+        inline Floats floats(double min = -1000.0, double max = 1000.0) { return Floats{min, max}; }
+        inline Booleans booleans() { return Booleans(); }
+        inline Strings strings(std::int64_t max_length = 64, bool unicode = true) { return Strings{max_length, unicode}; }
+        inline Vector3s vector3s(real_t range = 1000.0) { return Vector3s{range}; }
+        inline Transform3Ds transform3ds(real_t range = 1000.0, real_t max_scale = 10.0) { return Transform3Ds{range, max_scale}; }
+        inline PackedByteArrays packed_byte_arrays(std::int64_t max_size = 256) { return PackedByteArrays{max_size}; }
+        inline Variants variants(std::int64_t max_depth = 3) { return Variants{max_depth}; }
+    }
+
+    // The generators of the arguments of a property, as passed to CHECK_PROPERTY
+    template <class... Generators>
+    struct ForAll
+    {
+        std::tuple<Generators...> generators;
+    };
+
+    template <class... Generators>
+    ForAll<Generators...> for_all(Generators... generators)
+    {
+        return ForAll<Generators...>{std::make_tuple(generators...)};
+    }
+
+    struct PropertySettings
+    {
+        std::int64_t cases = 1000;
+        std::int64_t max_size = 100;
+        std::int64_t max_shrinks = 1000;
+        std::uint64_t seed = 0;
+    };
+
+    struct PropertyResult
+    {
+        bool passed = true;
+        std::int64_t cases_run = 0;
+        std::uint64_t seed = 0;
+        // The failing case and its own seed, which generates its arguments
+        std::int64_t failing_case = -1;
+        std::uint64_t failing_case_seed = 0;
+        // Errors printed through ErrorHandler by the shrunk case (which count as a failure)
+        std::int64_t error_count = 0;
+        std::int64_t shrinks = 0;
+        PackedStringArray original_arguments;
+        PackedStringArray shrunk_arguments;
+    };
+
+    namespace PropertyTesting
+    {
+        template <class Property, class Arguments>
+        bool holds(Property& property, const Arguments& arguments, std::int64_t& r_error_count)
+        {
+            bool result = false;
+            SUPPRESS_AND_COUNT_ALL_ERRORS(result = std::apply(property, arguments), r_error_count);
+            return result && r_error_count == 0;
+        }
+
+        template <class Arguments, std::size_t... Indices>
+        PackedStringArray describe(const Arguments& arguments, std::index_sequence<Indices...>)
+        {
+            PackedStringArray descriptions;
+            (descriptions.push_back(UtilityFunctions::str(std::get<Indices>(arguments))), ...);
+            return descriptions;
+        }
+
+        // Tries the candidates of argument Index in order, and keeps the first that still fails
+        template <std::size_t Index, class Generators, class Arguments, class Property>
+        bool shrink_argument(const Generators& generators, Arguments& r_arguments, Property& property, std::int64_t& r_error_count, std::int64_t& r_budget)
+        {
+            for (const auto& candidate : std::get<Index>(generators).shrink(std::get<Index>(r_arguments)))
+            {
+                if (r_budget-- <= 0)
+                    return false;
+                Arguments candidate_arguments = r_arguments;
+                std::get<Index>(candidate_arguments) = candidate;
+                std::int64_t error_count = 0;
+                if (!holds(property, candidate_arguments, error_count))
+                {
+                    r_arguments = std::move(candidate_arguments);
+                    r_error_count = error_count;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <class Generators, class Arguments, class Property, std::size_t... Indices>
+        bool shrink_step(const Generators& generators, Arguments& r_arguments, Property& property, std::int64_t& r_error_count, std::int64_t& r_budget, std::index_sequence<Indices...>)
+        {
+            return (shrink_argument<Indices>(generators, r_arguments, property, r_error_count, r_budget) || ...);
+        }
+    }
+
+    // Runs a property on generated arguments until it fails (returns false or prints an error),
+    // then shrinks the failing arguments one at a time, as long as the property keeps failing
+    template <class... Generators, class Property>
+    PropertyResult run_property(const ForAll<Generators...>& for_all, Property&& property, const PropertySettings& settings)
+    {
+        using Arguments = std::tuple<typename Generators::Value...>;
+        constexpr auto indices = std::index_sequence_for<Generators...>();
+
+        PropertyResult result;
+        result.seed = settings.seed;
+
+        Arguments arguments;
+        for (std::int64_t i = 0; i < settings.cases; ++i)
+        {
+            // Each case has its own seed, so that it does not depend on the cases before it
+            std::uint64_t case_seed = PropertyRandom::mix(settings.seed, std::uint64_t(i));
+            PropertyRandom random(case_seed);
+            std::int64_t size = 1 + (settings.max_size - 1) * i / std::max<std::int64_t>(settings.cases - 1, 1);
+            // Braces, so that the generators draw from random from left to right on every compiler
+            arguments = std::apply([&](const auto&... generators) { return Arguments{generators.generate(random, size)...}; }, for_all.generators);
+
+            result.cases_run++;
+            if (!PropertyTesting::holds(property, arguments, result.error_count))
+            {
+                result.passed = false;
+                result.failing_case = i;
+                result.failing_case_seed = case_seed;
+                break;
+            }
+        }
+        if (result.passed)
+            return result;
+
+        result.original_arguments = PropertyTesting::describe(arguments, indices);
+        std::int64_t budget = settings.max_shrinks;
+        while (budget > 0 && PropertyTesting::shrink_step(for_all.generators, arguments, property, result.error_count, budget, indices))
+            result.shrinks++;
+        result.shrunk_arguments = PropertyTesting::describe(arguments, indices);
+        return result;
+    }
+}
+
+#endif
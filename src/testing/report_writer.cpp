@@ -0,0 +1,197 @@
+#include "testing/report_writer.h"
+
+#include <godot_cpp/classes/json.hpp>
+
+#include "testing/test_macros.h"
+
+namespace godot::Testing
+{
+    static String format_seconds(std::int64_t usec)
+    {
+        return vformat("%.6f", double(usec) / 1.0e6);
+    }
+
+    // Lists the checks in a report with the given result, along with their details
+    static String format_check_records(const Ref<TestReport>& report, int result)
+    {
+        PackedStringArray lines;
+        for (const CheckRecord& record : report->get_check_records())
+        {
+            if (record.result != result)
+                continue;
+            lines.push_back(vformat("%s at %s:%s", record.check_string, record.file, record.line));
+            if (!record.details.is_empty())
+                lines.push_back(record.details);
+        }
+        return String("\n").join(lines);
+    }
+
+    ReportWriter::~ReportWriter()
+    {
+        close();
+    }
+
+    void ReportWriter::begin_test_suite(const String& test_suite_name)
+    {
+        if (m_file.is_null())
+        {
+            m_file = FileAccess::open(m_path, FileAccess::WRITE);
+            ERR_FAIL_COND_MSG(m_file.is_null(), vformat("Could not open report file: %s", m_path));
+            write_header();
+        }
+
+        m_test_suite_name = test_suite_name;
+        m_test_suite_test_cases = 0;
+        m_test_suite_failures = 0;
+        m_test_suite_errors = 0;
+        write_test_suite_start(test_suite_name);
+        m_file->flush();
+    }
+
+    void ReportWriter::write_test_case(const Ref<TestReport>& report)
+    {
+        if (m_file.is_null() || report.is_null())
+            return;
+
+        m_test_suite_test_cases++;
+        if (report->get_failed_checks() > 0)
+            m_test_suite_failures++;
+        if (report->get_errored_checks() > 0)
+            m_test_suite_errors++;
+        write_test_case_report(report);
+        m_file->flush();
+    }
+
+    void ReportWriter::end_test_suite(std::int64_t wall_clock_usec)
+    {
+        if (m_file.is_null())
+            return;
+
+        write_test_suite_end(wall_clock_usec);
+        m_file->flush();
+    }
+
+    void ReportWriter::close()
+    {
+        if (m_file.is_null())
+            return;
+
+        write_footer();
+        m_file->close();
+        m_file.unref();
+    }
+
+    String ReportWriter::get_path() const
+    {
+        return m_path;
+    }
+
+    void ReportWriter::set_path(const String& path)
+    {
+        m_path = path;
+    }
+
+    void ReportWriter::_bind_methods()
+    {
+        ClassDB::bind_method(D_METHOD("close"), &ReportWriter::close);
+
+        ClassDB::bind_method(D_METHOD("get_path"), &ReportWriter::get_path);
+        ClassDB::bind_method(D_METHOD("set_path", "path"), &ReportWriter::set_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "path", PROPERTY_HINT_SAVE_FILE), "set_path", "get_path");
+    }
+
+    JUnitReportWriter::~JUnitReportWriter()
+    {
+        close();
+    }
+
+    void JUnitReportWriter::write_header()
+    {
+        m_file->store_string("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n");
+    }
+
+    void JUnitReportWriter::write_test_suite_start(const String& test_suite_name)
+    {
+        m_file->store_string(vformat("  <testsuite name=\"%s\" ", test_suite_name.xml_escape(true)));
+
+        // The counts are not known yet, so reserve room for them and fill them in later
+        m_test_suite_attributes_position = m_file->get_position();
+        m_file->store_string(String(" ").repeat(96) + ">\n");
+    }
+
+    void JUnitReportWriter::write_test_case_report(const Ref<TestReport>& report)
+    {
+        m_file->store_string(vformat("    <testcase name=\"%s\" classname=\"%s\" time=\"%s\"",
+            report->get_test_case_name().xml_escape(true), m_test_suite_name.xml_escape(true), format_seconds(report->get_duration_usec())));
+
+        if (report->get_failed_checks() == 0 && report->get_errored_checks() == 0)
+        {
+            m_file->store_string("/>\n");
+            return;
+        }
+
+        m_file->store_string(">\n");
+        if (report->get_failed_checks() > 0)
+        {
+            m_file->store_string(vformat("      <failure message=\"%s failed checks\">%s</failure>\n",
+                report->get_failed_checks(), format_check_records(report, CHECK_FAILED).xml_escape()));
+        }
+        if (report->get_errored_checks() > 0)
+        {
+            m_file->store_string(vformat("      <error message=\"%s checks with unexpected errors\">%s</error>\n",
+                report->get_errored_checks(), format_check_records(report, CHECK_ERRORED).xml_escape()));
+        }
+        m_file->store_string("    </testcase>\n");
+    }
+
+    void JUnitReportWriter::write_test_suite_end(std::int64_t wall_clock_usec)
+    {
+        m_file->store_string("  </testsuite>\n");
+
+        String attributes = vformat("tests=\"%s\" failures=\"%s\" errors=\"%s\" time=\"%s\"",
+            m_test_suite_test_cases, m_test_suite_failures, m_test_suite_errors, format_seconds(wall_clock_usec));
+        std::uint64_t end_position = m_file->get_position();
+        m_file->seek(m_test_suite_attributes_position);
+        m_file->store_string(attributes.rpad(96));
+        m_file->seek(end_position);
+    }
+
+    void JUnitReportWriter::write_footer()
+    {
+        m_file->store_string("</testsuites>\n");
+    }
+
+    void JsonReportWriter::write_test_suite_start(const String& test_suite_name)
+    {
+        Dictionary line;
+        line["type"] = "test_suite_start";
+        line["test_suite"] = test_suite_name;
+        m_file->store_line(JSON::stringify(line));
+    }
+
+    void JsonReportWriter::write_test_case_report(const Ref<TestReport>& report)
+    {
+        Dictionary line;
+        line["type"] = "test_case";
+        line["test_suite"] = m_test_suite_name;
+        line["test_case"] = report->get_test_case_name();
+        line["passed_checks"] = report->get_passed_checks();
+        line["failed_checks"] = report->get_failed_checks();
+        line["errored_checks"] = report->get_errored_checks();
+        line["duration_usec"] = report->get_duration_usec();
+        line["failures"] = report->get_unpassed_checks();
+        m_file->store_line(JSON::stringify(line));
+    }
+
+    void JsonReportWriter::write_test_suite_end(std::int64_t wall_clock_usec)
+    {
+        Dictionary line;
+        line["type"] = "test_suite_end";
+        line["test_suite"] = m_test_suite_name;
+        line["test_cases"] = m_test_suite_test_cases;
+        line["failures"] = m_test_suite_failures;
+        line["errors"] = m_test_suite_errors;
+        line["wall_clock_usec"] = wall_clock_usec;
+        m_file->store_line(JSON::stringify(line));
+    }
+}
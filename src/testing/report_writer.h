@@ -0,0 +1,86 @@
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/resource.hpp>
+
+#include "testing/test_report.h"
+
+namespace godot::Testing
+{
+    // Streams test results to a file as each test case finishes, so that memory use does not
+    // grow with the number of test cases and the results written so far survive a crash. The
+    // file is opened (and truncated) by the first test suite written to it, and is closed by
+    // close() or when the writer is freed.
+    class ReportWriter : public Resource
+    {
+        GDCLASS(ReportWriter, Resource)
+
+    public:
+        ~ReportWriter();
+
+        void begin_test_suite(const String& test_suite_name);
+        void write_test_case(const Ref<TestReport>& report);
+        void end_test_suite(std::int64_t wall_clock_usec);
+        void close();
+
+        String get_path() const;
+        void set_path(const String& path);
+
+    protected:
+        static void _bind_methods();
+
+        virtual void write_header() {}
+        virtual void write_test_suite_start(const String& test_suite_name) {}
+        virtual void write_test_case_report(const Ref<TestReport>& report) {}
+        virtual void write_test_suite_end(std::int64_t wall_clock_usec) {}
+        virtual void write_footer() {}
+
+        String m_path;
+        Ref<FileAccess> m_file;
+
+        String m_test_suite_name;
+        std::int64_t m_test_suite_test_cases = 0;
+        std::int64_t m_test_suite_failures = 0;
+        std::int64_t m_test_suite_errors = 0;
+    };
+
+    // Writes results in the JUnit XML format. Each test suite becomes a <testsuite> element whose
+    // counts are patched in once the test suite is done.
+    class JUnitReportWriter : public ReportWriter
+    {
+        GDCLASS(JUnitReportWriter, ReportWriter)
+
+    public:
+        // The footer can only be written while this is still a JUnitReportWriter
+        ~JUnitReportWriter();
+
+    protected:
+        static void _bind_methods() {}
+
+        void write_header() override;
+        void write_test_suite_start(const String& test_suite_name) override;
+        void write_test_case_report(const Ref<TestReport>& report) override;
+        void write_test_suite_end(std::int64_t wall_clock_usec) override;
+        void write_footer() override;
+
+    private:
+        // Where the placeholder attributes of the current <testsuite> element start
+        std::uint64_t m_test_suite_attributes_position = 0;
+    };
+
+    // Writes results as JSON, one object per line
+    class JsonReportWriter : public ReportWriter
+    {
+        GDCLASS(JsonReportWriter, ReportWriter)
+
+    protected:
+        static void _bind_methods() {}
+
+        void write_test_suite_start(const String& test_suite_name) override;
+        void write_test_case_report(const Ref<TestReport>& report) override;
+        void write_test_suite_end(std::int64_t wall_clock_usec) override;
+    };
+}
+
+#endif
@@ -0,0 +1,459 @@
+#include "testing/shard_coordinator.h"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/json.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+#include "testing/test_macros.h"
+
+namespace godot::Testing
+{
+    // Used for test cases without a remembered duration when the cache is empty
+    static constexpr std::int64_t DEFAULT_DURATION_USEC = 1000;
+
+    ShardCoordinator::~ShardCoordinator()
+    {
+        // Workers must not outlive the coordinator that would merge their results
+        kill_workers();
+    }
+
+    void ShardCoordinator::add_test_case(const String& test_suite_class, const String& test_case_class)
+    {
+        m_test_cases.push_back({test_suite_class, test_case_class});
+    }
+
+    std::int64_t ShardCoordinator::get_test_case_count() const
+    {
+        return m_test_cases.size();
+    }
+
+    std::vector<std::vector<ShardCoordinator::PlannedTestCase>> ShardCoordinator::assign_shards(std::vector<std::int64_t>& r_shard_durations) const
+    {
+        std::int64_t default_duration_usec = DEFAULT_DURATION_USEC;
+        if (m_result_cache.is_valid() && m_result_cache->get_typical_duration_usec() > 0)
+            default_duration_usec = m_result_cache->get_typical_duration_usec();
+
+        std::vector<std::int64_t> durations;
+        durations.reserve(m_test_cases.size());
+        for (const PlannedTestCase& test_case : m_test_cases)
+        {
+            std::int64_t duration_usec = default_duration_usec;
+            if (m_result_cache.is_valid())
+                duration_usec = m_result_cache->get_duration_usec(TestResultCache::make_key(test_case.test_suite_class, test_case.test_case_class), default_duration_usec);
+            durations.push_back(duration_usec);
+        }
+
+        // Longest processing time first: hand out the longest test cases first, each to the shard
+        // with the least work so far
+        std::vector<std::size_t> order(m_test_cases.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return durations[a] > durations[b]; });
+
+        std::int64_t shard_count = std::max<std::int64_t>(m_shard_count, 1);
+        std::vector<std::vector<PlannedTestCase>> shards(shard_count);
+        r_shard_durations.assign(shard_count, 0);
+        for (std::size_t index : order)
+        {
+            std::size_t shard_index = std::min_element(r_shard_durations.begin(), r_shard_durations.end()) - r_shard_durations.begin();
+            shards[shard_index].push_back(m_test_cases[index]);
+            r_shard_durations[shard_index] += durations[index];
+        }
+        return shards;
+    }
+
+    Array ShardCoordinator::plan_shards() const
+    {
+        std::vector<std::int64_t> shard_durations;
+        return make_plan(assign_shards(shard_durations));
+    }
+
+    Array ShardCoordinator::make_plan(const std::vector<std::vector<PlannedTestCase>>& shards)
+    {
+        Array plan;
+        for (const std::vector<PlannedTestCase>& shard : shards)
+        {
+            Dictionary shard_plan;
+            for (const PlannedTestCase& test_case : shard)
+            {
+                if (!shard_plan.has(test_case.test_suite_class))
+                    shard_plan[test_case.test_suite_class] = PackedStringArray();
+                PackedStringArray test_case_classes = shard_plan[test_case.test_suite_class];
+                test_case_classes.push_back(test_case.test_case_class);
+                shard_plan[test_case.test_suite_class] = test_case_classes;
+            }
+            plan.push_back(shard_plan);
+        }
+        return plan;
+    }
+
+    Error ShardCoordinator::start(const String& runner_scene_path, const PackedStringArray& worker_arguments)
+    {
+        for (const Worker& worker : m_workers)
+            ERR_FAIL_COND_V_MSG(worker.running, ERR_ALREADY_IN_USE, "The shard workers are already running.");
+        m_workers.clear();
+
+        Error error = DirAccess::make_dir_recursive_absolute(SHARD_DIRECTORY);
+        if (error != OK)
+            return error;
+
+        std::vector<std::int64_t> shard_durations;
+        std::vector<std::vector<PlannedTestCase>> shards = assign_shards(shard_durations);
+        Array plan = make_plan(shards);
+
+        String plan_path = String(SHARD_DIRECTORY).path_join("plan.json");
+        Ref<FileAccess> plan_file = FileAccess::open(plan_path, FileAccess::WRITE);
+        if (plan_file.is_null())
+            return FileAccess::get_open_error();
+        plan_file->store_string(JSON::stringify(plan, "\t"));
+        plan_file->close();
+
+        OS* os = OS::get_singleton();
+        ProjectSettings* project_settings = ProjectSettings::get_singleton();
+        m_run_start_usec = Time::get_singleton()->get_ticks_usec();
+
+        for (std::int64_t i = 0; i < std::int64_t(shards.size()); ++i)
+        {
+            if (shards[i].empty())
+                continue;
+
+            Worker worker;
+            worker.shard_index = i;
+            worker.json_path = String(SHARD_DIRECTORY).path_join(vformat("shard_%d.jsonl", i));
+            worker.test_cases = std::move(shards[i]);
+            if (m_timeout_scale > 0.0)
+                worker.timeout_usec = std::max(m_min_timeout_usec, std::int64_t(double(shard_durations[i]) * m_timeout_scale));
+            // A stale file from an earlier run would hide a crash before the first test case
+            if (FileAccess::file_exists(worker.json_path))
+                DirAccess::remove_absolute(worker.json_path);
+
+            PackedStringArray arguments;
+            arguments.push_back("--headless");
+            arguments.push_back("--quiet");
+            arguments.push_back("--path");
+            arguments.push_back(project_settings->globalize_path("res://"));
+            arguments.push_back(runner_scene_path);
+            arguments.push_back("--");
+            arguments.append_array(worker_arguments);
+            arguments.push_back(vformat("--shard-plan=%s", project_settings->globalize_path(plan_path)));
+            arguments.push_back(vformat("--shard-index=%d", i));
+            arguments.push_back(vformat("--json=%s", project_settings->globalize_path(worker.json_path)));
+
+            worker.pid = os->create_process(os->get_executable_path(), arguments);
+            if (worker.pid < 0)
+            {
+                UtilityFunctions::printerr(vformat("Could not start the worker for shard %d.", i));
+                worker.exit_code = -1;
+            }
+            else
+            {
+                worker.running = true;
+            }
+            m_workers.push_back(std::move(worker));
+        }
+
+        return OK;
+    }
+
+    bool ShardCoordinator::poll()
+    {
+        OS* os = OS::get_singleton();
+        std::int64_t elapsed_usec = Time::get_singleton()->get_ticks_usec() - m_run_start_usec;
+        bool all_exited = true;
+        for (Worker& worker : m_workers)
+        {
+            if (!worker.running)
+                continue;
+
+            if (worker.timeout_usec > 0 && elapsed_usec > worker.timeout_usec)
+            {
+                // A hung worker (such as an asynchronous test case that never completes) only
+                // costs the test cases of its own shard that it has not reported yet
+                os->kill(worker.pid);
+                worker.running = false;
+                worker.timed_out = true;
+                continue;
+            }
+
+            if (os->is_process_running(worker.pid))
+            {
+                all_exited = false;
+                continue;
+            }
+
+            worker.running = false;
+            worker.exit_code = os->get_process_exit_code(worker.pid);
+        }
+        return all_exited;
+    }
+
+    void ShardCoordinator::kill_workers()
+    {
+        OS* os = OS::get_singleton();
+        for (Worker& worker : m_workers)
+        {
+            if (!worker.running || os == nullptr)
+                continue;
+            os->kill(worker.pid);
+            worker.running = false;
+        }
+    }
+
+    std::int64_t ShardCoordinator::merge_results(const Ref<OutputSink>& output_sink)
+    {
+        std::int64_t wall_clock_usec = Time::get_singleton()->get_ticks_usec() - m_run_start_usec;
+        std::int64_t passed_test_cases = 0;
+        std::int64_t mixed_test_cases = 0;
+        std::int64_t failed_test_cases = 0;
+        std::int64_t errored_test_cases = 0;
+        std::int64_t unpassed_test_cases = 0;
+        std::int64_t skipped_test_cases = 0;
+        std::int64_t total_duration_usec = 0;
+        m_unreported_test_cases.clear();
+
+        for (const Worker& worker : m_workers)
+        {
+            std::set<String> reported_keys;
+            bool stopped_early = false;
+            PackedStringArray lines;
+            if (FileAccess::file_exists(worker.json_path))
+                lines = FileAccess::get_file_as_string(worker.json_path).split("\n", false);
+
+            for (std::int64_t i = 0; i < lines.size(); ++i)
+            {
+                Variant parsed_line = JSON::parse_string(lines[i]);
+                if (parsed_line.get_type() != Variant::DICTIONARY)
+                    continue;
+                Dictionary line = parsed_line;
+                if (String(line.get("type", "")) == "stopped_early")
+                    stopped_early = true;
+                if (String(line.get("type", "")) != "test_case")
+                    continue;
+
+                String test_suite_class = line.get("test_suite", "");
+                String test_case_class = line.get("test_case", "");
+                std::int64_t passed_checks = line.get("passed_checks", 0);
+                std::int64_t failed_checks = line.get("failed_checks", 0);
+                std::int64_t errored_checks = line.get("errored_checks", 0);
+                std::int64_t duration_usec = line.get("duration_usec", 0);
+                String key = TestResultCache::make_key(test_suite_class, test_case_class);
+                reported_keys.insert(key);
+                total_duration_usec += duration_usec;
+
+                String result;
+                if (errored_checks > 0)
+                    result = "errored";
+                else if (failed_checks == 0)
+                    result = "passed";
+                else if (passed_checks == 0)
+                    result = "failed";
+                else
+                    result = "mixed";
+
+                if (failed_checks == 0)
+                    passed_test_cases++;
+                else if (passed_checks == 0)
+                    failed_test_cases++;
+                else
+                    mixed_test_cases++;
+                if (errored_checks > 0)
+                    errored_test_cases++;
+
+                if (m_result_cache.is_valid())
+                    m_result_cache->record(key, result, duration_usec);
+
+                if (result == "passed")
+                    continue;
+                unpassed_test_cases++;
+
+                output_sink->print_line(vformat("%s[%s]%s %s (shard %d)", result == "errored" ? ERRORED_START : (result == "failed" ? FAILED_START : MIXED_START),
+                    result.to_upper(), result == "errored" ? ERRORED_END : (result == "failed" ? FAILED_END : MIXED_END), key, worker.shard_index));
+                Array failures = line.get("failures", Array());
+                for (std::int64_t j = 0; j < failures.size(); ++j)
+                {
+                    Dictionary failure = failures[j];
+                    output_sink->print_line(vformat("    %s at %s:%s", failure.get("check", ""), failure.get("file", ""), failure.get("line", 0)));
+                }
+            }
+
+            // Everything the worker never got to report is blamed on the worker
+            for (const PlannedTestCase& test_case : worker.test_cases)
+            {
+                String key = TestResultCache::make_key(test_case.test_suite_class, test_case.test_case_class);
+                if (reported_keys.count(key) > 0)
+                    continue;
+
+                // A worker stopped by --fail-fast did not run the rest of its shard, which is
+                // neither an error nor worth remembering in the result cache
+                if (stopped_early)
+                {
+                    skipped_test_cases++;
+                    output_sink->print_line(vformat("[SKIPPED] %s (shard %d stopped after the first failure)", key, worker.shard_index));
+                    continue;
+                }
+
+                errored_test_cases++;
+                unpassed_test_cases++;
+                String reason;
+                if (worker.timed_out)
+                    reason = vformat("shard %d was killed after %.1f s without reporting it", worker.shard_index, worker.timeout_usec / 1.0e6);
+                else
+                    reason = vformat("shard %d exited with code %d before reporting it", worker.shard_index, worker.exit_code);
+                output_sink->print_line(vformat("%s[ERRORED]%s %s (%s)", ERRORED_START, ERRORED_END, key, reason));
+                if (m_result_cache.is_valid())
+                    m_result_cache->record(key, "errored", m_result_cache->get_duration_usec(key, 0));
+
+                // Recorded for the merged reports, so that they agree with the summary
+                Ref<TestReport> report;
+                report.instantiate();
+                report->set_test_case_name(test_case.test_case_class);
+                report->add_check("SHARD_WORKER_REPORTED(test_case)", __FILE__, __LINE__, CHECK_ERRORED, 1, 0, "        " + reason);
+                report->set_check_counts(0, 0, 1);
+                m_unreported_test_cases.push_back({test_case.test_suite_class, report});
+            }
+        }
+
+        output_sink->print_line(vformat("\n%sSharded run%s results (%d shards):", TEST_NAME_START, TEST_NAME_END, std::int64_t(m_workers.size())));
+        output_sink->print_line(vformat("    test cases passed: %s%s%s", PASSED_START, passed_test_cases, PASSED_END));
+        output_sink->print_line(vformat("    test cases mixed: %s%s%s", MIXED_START, mixed_test_cases, MIXED_END));
+        output_sink->print_line(vformat("    test cases failed: %s%s%s", FAILED_START, failed_test_cases, FAILED_END));
+        output_sink->print_line(vformat("    test cases with unexpected errors: %s%s%s", ERRORED_START, errored_test_cases, ERRORED_END));
+        if (skipped_test_cases > 0)
+            output_sink->print_line(vformat("    test cases skipped after the first failure: %s", skipped_test_cases));
+        output_sink->print_line(vformat("    wall-clock time: %.3f ms", wall_clock_usec / 1000.0));
+        if (wall_clock_usec > 0)
+            output_sink->print_line(vformat("    speedup: %.2fx", double(total_duration_usec) / double(wall_clock_usec)));
+        output_sink->flush();
+
+        if (m_result_cache.is_valid())
+        {
+            Error error = m_result_cache->save();
+            if (error != OK)
+                UtilityFunctions::printerr(vformat("Could not save the test result cache to %s: %s", m_result_cache->get_path(), UtilityFunctions::error_string(error)));
+        }
+
+        return unpassed_test_cases;
+    }
+
+    Error ShardCoordinator::write_merged_json(const String& path) const
+    {
+        Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+        if (file.is_null())
+            return FileAccess::get_open_error();
+
+        for (const Worker& worker : m_workers)
+        {
+            if (FileAccess::file_exists(worker.json_path))
+                file->store_string(FileAccess::get_file_as_string(worker.json_path));
+        }
+
+        if (!m_unreported_test_cases.empty())
+        {
+            String unreported_path = String(SHARD_DIRECTORY).path_join("unreported.jsonl");
+            Ref<JsonReportWriter> json_report_writer;
+            json_report_writer.instantiate();
+            json_report_writer->set_path(unreported_path);
+            write_unreported_test_cases(json_report_writer);
+            file->store_string(FileAccess::get_file_as_string(unreported_path));
+        }
+        return OK;
+    }
+
+    void ShardCoordinator::write_unreported_test_cases(const Ref<ReportWriter>& report_writer) const
+    {
+        // Grouped by test suite, in the order the test suites first appear
+        std::vector<String> test_suite_classes;
+        for (const UnreportedTestCase& unreported_test_case : m_unreported_test_cases)
+        {
+            if (std::find(test_suite_classes.begin(), test_suite_classes.end(), unreported_test_case.test_suite_class) == test_suite_classes.end())
+                test_suite_classes.push_back(unreported_test_case.test_suite_class);
+        }
+
+        for (const String& test_suite_class : test_suite_classes)
+        {
+            report_writer->begin_test_suite(test_suite_class);
+            for (const UnreportedTestCase& unreported_test_case : m_unreported_test_cases)
+            {
+                if (unreported_test_case.test_suite_class == test_suite_class)
+                    report_writer->write_test_case(unreported_test_case.report);
+            }
+            report_writer->end_test_suite(0);
+        }
+        report_writer->close();
+    }
+
+    std::int64_t ShardCoordinator::get_shard_count() const
+    {
+        return m_shard_count;
+    }
+
+    void ShardCoordinator::set_shard_count(std::int64_t shard_count)
+    {
+        m_shard_count = shard_count;
+    }
+
+    Ref<TestResultCache> ShardCoordinator::get_result_cache() const
+    {
+        return m_result_cache;
+    }
+
+    void ShardCoordinator::set_result_cache(const Ref<TestResultCache>& result_cache)
+    {
+        m_result_cache = result_cache;
+    }
+
+    double ShardCoordinator::get_timeout_scale() const
+    {
+        return m_timeout_scale;
+    }
+
+    void ShardCoordinator::set_timeout_scale(double timeout_scale)
+    {
+        m_timeout_scale = timeout_scale;
+    }
+
+    std::int64_t ShardCoordinator::get_min_timeout_usec() const
+    {
+        return m_min_timeout_usec;
+    }
+
+    void ShardCoordinator::set_min_timeout_usec(std::int64_t min_timeout_usec)
+    {
+        m_min_timeout_usec = min_timeout_usec;
+    }
+
+    void ShardCoordinator::_bind_methods()
+    {
+        ClassDB::bind_method(D_METHOD("add_test_case", "test_suite_class", "test_case_class"), &ShardCoordinator::add_test_case);
+        ClassDB::bind_method(D_METHOD("get_test_case_count"), &ShardCoordinator::get_test_case_count);
+        ClassDB::bind_method(D_METHOD("plan_shards"), &ShardCoordinator::plan_shards);
+        ClassDB::bind_method(D_METHOD("start", "runner_scene_path", "worker_arguments"), &ShardCoordinator::start);
+        ClassDB::bind_method(D_METHOD("poll"), &ShardCoordinator::poll);
+        ClassDB::bind_method(D_METHOD("kill_workers"), &ShardCoordinator::kill_workers);
+        ClassDB::bind_method(D_METHOD("merge_results", "output_sink"), &ShardCoordinator::merge_results);
+        ClassDB::bind_method(D_METHOD("write_merged_json", "path"), &ShardCoordinator::write_merged_json);
+        ClassDB::bind_method(D_METHOD("write_unreported_test_cases", "report_writer"), &ShardCoordinator::write_unreported_test_cases);
+
+        ClassDB::bind_method(D_METHOD("get_shard_count"), &ShardCoordinator::get_shard_count);
+        ClassDB::bind_method(D_METHOD("set_shard_count", "shard_count"), &ShardCoordinator::set_shard_count);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "shard_count", PROPERTY_HINT_RANGE, "1,256,1,or_greater"), "set_shard_count", "get_shard_count");
+
+        ClassDB::bind_method(D_METHOD("get_result_cache"), &ShardCoordinator::get_result_cache);
+        ClassDB::bind_method(D_METHOD("set_result_cache", "result_cache"), &ShardCoordinator::set_result_cache);
+
+        ClassDB::bind_method(D_METHOD("get_timeout_scale"), &ShardCoordinator::get_timeout_scale);
+        ClassDB::bind_method(D_METHOD("set_timeout_scale", "timeout_scale"), &ShardCoordinator::set_timeout_scale);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "timeout_scale"), "set_timeout_scale", "get_timeout_scale");
+
+        ClassDB::bind_method(D_METHOD("get_min_timeout_usec"), &ShardCoordinator::get_min_timeout_usec);
+        ClassDB::bind_method(D_METHOD("set_min_timeout_usec", "min_timeout_usec"), &ShardCoordinator::set_min_timeout_usec);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "min_timeout_usec"), "set_min_timeout_usec", "get_min_timeout_usec");
+    }
+}
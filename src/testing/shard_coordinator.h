@@ -0,0 +1,115 @@
+#ifndef SHARD_COORDINATOR_H
+#define SHARD_COORDINATOR_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+
+#include <vector>
+
+#include "testing/output_sink.h"
+#include "testing/report_writer.h"
+#include "testing/test_result_cache.h"
+
+namespace godot::Testing
+{
+    // Splits test cases into shards and runs each shard in its own headless Godot process. The
+    // shards are balanced by the durations remembered in the result cache (longest first, each to
+    // the least loaded shard), and every worker writes its results as JSON lines, which are
+    // merged once all workers have exited. Test cases that a crashed worker never reported count
+    // as errored, so a crash only affects the rest of its own shard. A worker that runs for much
+    // longer than its shard was planned to take is taken to be hung, and is killed the same way.
+    class ShardCoordinator : public RefCounted
+    {
+        GDCLASS(ShardCoordinator, RefCounted)
+
+    public:
+        static constexpr const char* SHARD_DIRECTORY = "user://test_shards";
+
+        ~ShardCoordinator();
+
+        void add_test_case(const String& test_suite_class, const String& test_case_class);
+        std::int64_t get_test_case_count() const;
+
+        // Assigns the test cases to shards. Each shard is a dictionary from test suite class to
+        // the test case classes it runs.
+        Array plan_shards() const;
+
+        // Writes the plan and launches one worker per non-empty shard. The worker arguments are
+        // passed after "--", and each worker also gets --shard-plan, --shard-index, and --json.
+        Error start(const String& runner_scene_path, const PackedStringArray& worker_arguments);
+        // Returns true once every worker has exited (or was killed for running past its timeout)
+        bool poll();
+        void kill_workers();
+
+        // Prints the merged results, records them in the result cache, and returns the number of
+        // test cases that failed or errored (including those a crashed worker never reported)
+        std::int64_t merge_results(const Ref<OutputSink>& output_sink);
+
+        // Appends the merged JSON lines of all shards to a single file, followed by an errored
+        // record for each test case a worker never reported (after merge_results())
+        Error write_merged_json(const String& path) const;
+
+        // Writes an errored record for each test case a worker never reported (after
+        // merge_results()), such as to a JUnit file next to those of the workers
+        void write_unreported_test_cases(const Ref<ReportWriter>& report_writer) const;
+
+        std::int64_t get_shard_count() const;
+        void set_shard_count(std::int64_t shard_count);
+
+        Ref<TestResultCache> get_result_cache() const;
+        void set_result_cache(const Ref<TestResultCache>& result_cache);
+
+        // Each worker is killed once it has run for timeout_scale times the planned duration of
+        // its shard, or for min_timeout_usec if that is longer. Zero or less turns the timeout off.
+        double get_timeout_scale() const;
+        void set_timeout_scale(double timeout_scale);
+
+        // Leaves room for starting Godot, and for shards of test cases that have never run
+        std::int64_t get_min_timeout_usec() const;
+        void set_min_timeout_usec(std::int64_t min_timeout_usec);
+
+    protected:
+        static void _bind_methods();
+
+    private:
+        struct PlannedTestCase
+        {
+            String test_suite_class;
+            String test_case_class;
+        };
+
+        struct Worker
+        {
+            std::int64_t shard_index = 0;
+            std::int64_t pid = -1;
+            int exit_code = -1;
+            bool running = false;
+            bool timed_out = false;
+            std::int64_t timeout_usec = 0;
+            String json_path;
+            std::vector<PlannedTestCase> test_cases;
+        };
+
+        std::vector<std::vector<PlannedTestCase>> assign_shards(std::vector<std::int64_t>& r_shard_durations) const;
+        static Array make_plan(const std::vector<std::vector<PlannedTestCase>>& shards);
+
+        std::int64_t m_run_start_usec = 0;
+
+        std::int64_t m_shard_count = 2;
+        Ref<TestResultCache> m_result_cache;
+        double m_timeout_scale = 10.0;
+        std::int64_t m_min_timeout_usec = 60000000;
+
+        struct UnreportedTestCase
+        {
+            String test_suite_class;
+            Ref<TestReport> report;
+        };
+
+        std::vector<PlannedTestCase> m_test_cases;
+        std::vector<Worker> m_workers;
+        std::vector<UnreportedTestCase> m_unreported_test_cases;
+    };
+}
+
+#endif
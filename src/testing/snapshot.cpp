@@ -0,0 +1,171 @@
+#include "testing/snapshot.h"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/hashing_context.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "testing/container_diff.h"
+
+namespace godot::Testing
+{
+    static constexpr std::int64_t READ_CHUNK_SIZE = 1024 * 1024;
+
+    static String get_sidecar_path(const String& path)
+    {
+        return path + ".sha256";
+    }
+
+    static String hash_bytes(const PackedByteArray& bytes)
+    {
+        Ref<HashingContext> hashing_context;
+        hashing_context.instantiate();
+        hashing_context->start(HashingContext::HASH_SHA256);
+        hashing_context->update(bytes);
+        return hashing_context->finish().hex_encode();
+    }
+
+    // The hash in a sidecar, which uses the format of sha256sum ("<hash>  <file name>"), or an
+    // empty string if the sidecar cannot be trusted
+    static String read_sidecar_hash(const String& path)
+    {
+        String sidecar_path = get_sidecar_path(path);
+        if (!FileAccess::file_exists(sidecar_path) || FileAccess::get_modified_time(sidecar_path) < FileAccess::get_modified_time(path))
+            return String();
+        return FileAccess::get_file_as_string(sidecar_path).get_slice(" ", 0).strip_edges();
+    }
+
+    static Error write_sidecar(const String& path, const String& hash)
+    {
+        Ref<FileAccess> sidecar_file = FileAccess::open(get_sidecar_path(path), FileAccess::WRITE);
+        if (sidecar_file.is_null())
+            return FileAccess::get_open_error();
+        sidecar_file->store_string(vformat("%s  %s\n", hash, path.get_file()));
+        return OK;
+    }
+
+    static Error write_snapshot(const String& path, const PackedByteArray& bytes, const String& hash)
+    {
+        DirAccess::make_dir_recursive_absolute(path.get_base_dir());
+
+        Ref<FileAccess> snapshot_file = FileAccess::open(path, FileAccess::WRITE);
+        if (snapshot_file.is_null())
+            return FileAccess::get_open_error();
+        snapshot_file->store_buffer(bytes);
+        snapshot_file->close();
+
+        // Written after the snapshot, so that it is not older than the snapshot
+        return write_sidecar(path, hash);
+    }
+
+    // Reads the snapshot in chunks, comparing each with the value's bytes and hashing it
+    static Error compare_bytes(const String& path, const PackedByteArray& bytes, SnapshotComparison& r_comparison)
+    {
+        Ref<FileAccess> snapshot_file = FileAccess::open(path, FileAccess::READ);
+        if (snapshot_file.is_null())
+            return FileAccess::get_open_error();
+
+        r_comparison.compared_bytes = true;
+        r_comparison.expected_size = std::int64_t(snapshot_file->get_length());
+
+        Ref<HashingContext> hashing_context;
+        hashing_context.instantiate();
+        hashing_context->start(HashingContext::HASH_SHA256);
+
+        std::int64_t offset = 0;
+        while (offset < r_comparison.expected_size)
+        {
+            PackedByteArray chunk = snapshot_file->get_buffer(std::min(READ_CHUNK_SIZE, r_comparison.expected_size - offset));
+            if (chunk.is_empty())
+                return snapshot_file->get_error();
+            hashing_context->update(chunk);
+
+            if (r_comparison.first_difference < 0)
+            {
+                std::int64_t common_size = std::max<std::int64_t>(0, std::min(chunk.size(), bytes.size() - offset));
+                if (std::memcmp(chunk.ptr(), bytes.ptr() + offset, common_size) != 0)
+                {
+                    for (std::int64_t i = 0; i < common_size; ++i)
+                    {
+                        if (chunk[i] != bytes[offset + i])
+                        {
+                            r_comparison.first_difference = offset + i;
+                            break;
+                        }
+                    }
+                }
+                else if (common_size < chunk.size())
+                {
+                    r_comparison.first_difference = offset + common_size;
+                }
+            }
+            offset += chunk.size();
+        }
+
+        if (r_comparison.first_difference < 0 && r_comparison.expected_size != bytes.size())
+            r_comparison.first_difference = std::min(r_comparison.expected_size, bytes.size());
+        r_comparison.expected_hash = hashing_context->finish().hex_encode();
+        return OK;
+    }
+
+    SnapshotComparison compare_with_snapshot(const Variant& value, const String& path, bool update)
+    {
+        SnapshotComparison comparison;
+        comparison.path = path;
+
+        PackedByteArray bytes = UtilityFunctions::var_to_bytes(value);
+        comparison.actual_size = bytes.size();
+        comparison.actual_hash = hash_bytes(bytes);
+
+        bool exists = FileAccess::file_exists(path);
+        bool readable = false;
+        if (exists)
+        {
+            String sidecar_hash = read_sidecar_hash(path);
+            if (sidecar_hash == comparison.actual_hash)
+            {
+                comparison.expected_hash = sidecar_hash;
+                comparison.expected_size = comparison.actual_size;
+                comparison.status = update ? SnapshotComparison::UPDATED : SnapshotComparison::MATCHED;
+                return comparison;
+            }
+
+            comparison.error = compare_bytes(path, bytes, comparison);
+            readable = comparison.error == OK;
+            // An unreadable snapshot is simply replaced in update mode
+            if (!readable && !update)
+            {
+                comparison.status = SnapshotComparison::FILE_ERROR;
+                return comparison;
+            }
+        }
+
+        bool matches = readable && comparison.first_difference < 0;
+        if (update)
+        {
+            // A matching snapshot only gets a fresh sidecar, so that it is not touched
+            comparison.error = matches ? write_sidecar(path, comparison.actual_hash) : write_snapshot(path, bytes, comparison.actual_hash);
+            comparison.status = comparison.error == OK ? SnapshotComparison::UPDATED : SnapshotComparison::FILE_ERROR;
+            return comparison;
+        }
+
+        if (!exists)
+        {
+            comparison.status = SnapshotComparison::MISSING;
+            return comparison;
+        }
+        if (matches)
+        {
+            comparison.status = SnapshotComparison::MATCHED;
+            return comparison;
+        }
+
+        comparison.status = SnapshotComparison::MISMATCHED;
+        if (comparison.expected_size <= MAX_DIFFED_SNAPSHOT_SIZE)
+            comparison.diff_lines = diff_containers(UtilityFunctions::bytes_to_var(FileAccess::get_file_as_bytes(path)), value);
+        return comparison;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+namespace godot::Testing
+{
+    struct SnapshotComparison
+    {
+        enum Status
+        {
+            MATCHED,
+            MISMATCHED,
+            // There is no snapshot file yet
+            MISSING,
+            // The snapshot was rewritten (or already matched) in update mode
+            UPDATED,
+            // The snapshot could not be read or written
+            FILE_ERROR,
+        };
+
+        Status status = MATCHED;
+        Error error = OK;
+        String path;
+        String actual_hash;
+        String expected_hash;
+        std::int64_t actual_size = 0;
+        std::int64_t expected_size = 0;
+        // The offset of the first differing byte, if the bytes were compared
+        std::int64_t first_difference = -1;
+        // Whether the snapshot file had to be read (rather than only its hash sidecar)
+        bool compared_bytes = false;
+        // A summary of the differences between the decoded snapshot and the value
+        PackedStringArray diff_lines;
+    };
+
+    // Compares the serialization of a value (var_to_bytes, without objects) with a snapshot file.
+    // Next to each snapshot, a ".sha256" sidecar holds the hash of the snapshot (in the format of
+    // sha256sum), so that a matching value is confirmed without reading the snapshot at all. The
+    // snapshot is only read (in chunks) when the sidecar is missing, older than the snapshot, or does
+    // not match. In update mode, the snapshot and sidecar are rewritten unless they already match,
+    // including when the old snapshot cannot be read.
+    SnapshotComparison compare_with_snapshot(const Variant& value, const String& path, bool update);
+
+    // Snapshots up to this size are decoded to describe how they differ from the value
+    static constexpr std::int64_t MAX_DIFFED_SNAPSHOT_SIZE = 16 * 1024 * 1024;
+}
+
+#endif
@@ -0,0 +1,233 @@
+#include "testing/stress_test_case.h"
+
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/variant/array.hpp>
+
+#include <algorithm>
+#include <thread>
+
+#include "testing/benchmark_case.h"
+
+namespace godot::Testing
+{
+    void StressTestCase::begin_run()
+    {
+        TestCase::begin_run();
+
+        // Stress tests that were renamed or removed do not keep their results from earlier runs
+        m_stress_results.clear();
+    }
+
+    int StressTestCase::run_stress_threads(const String& name, const char* file, int line, const StressThread& stress_thread)
+    {
+        m_stress_results[name] = Array();
+
+        int worst_result = CHECK_PASSED;
+        double first_ops_per_second = 0.0;
+        std::int64_t first_thread_count = 0;
+        for (std::int64_t i = 0; i < m_thread_counts.size(); ++i)
+        {
+            std::int64_t check_start_nsec = start_check_timer();
+            std::int64_t thread_count = std::max<std::int32_t>(m_thread_counts[i], 1);
+
+            m_stress_thread = &stress_thread;
+            m_thread_results.assign(thread_count, StressThreadResult());
+            m_arrived_threads = 0;
+            m_running_threads = 0;
+            m_peak_concurrency = 0;
+
+            WorkerThreadPool* worker_thread_pool = WorkerThreadPool::get_singleton();
+            std::int64_t group_id = worker_thread_pool->add_group_task(
+                callable_mp(this, &StressTestCase::run_stress_thread),
+                thread_count, thread_count, true, vformat("%s stress test", this->get_class()));
+            worker_thread_pool->wait_for_group_task_completion(group_id);
+            m_stress_thread = nullptr;
+
+            StressRunStats stats;
+            stats.thread_count = thread_count;
+            stats.peak_concurrency = m_peak_concurrency;
+            std::int64_t start_nsec = m_thread_results.front().start_nsec;
+            std::int64_t end_nsec = m_thread_results.front().end_nsec;
+            for (const StressThreadResult& thread_result : m_thread_results)
+            {
+                stats.iterations += thread_result.iterations;
+                stats.barrier_timed_out = stats.barrier_timed_out || thread_result.barrier_timed_out;
+                start_nsec = std::min(start_nsec, thread_result.start_nsec);
+                end_nsec = std::max(end_nsec, thread_result.end_nsec);
+            }
+            stats.wall_nsec = double(end_nsec - start_nsec);
+            stats.ops_per_second = stats.wall_nsec > 0.0 ? double(stats.iterations) * 1.0e9 / stats.wall_nsec : 0.0;
+
+            if (i == 0)
+            {
+                first_ops_per_second = stats.ops_per_second;
+                first_thread_count = thread_count;
+            }
+            worst_result = std::min(worst_result, report_stress_run(name, file, line, check_start_nsec, stats, first_ops_per_second, first_thread_count));
+        }
+
+        m_thread_results.clear();
+        return worst_result;
+    }
+
+    void StressTestCase::run_stress_thread(std::uint32_t thread_index)
+    {
+        StressThreadResult& result = m_thread_results[thread_index];
+        std::int64_t thread_count = m_thread_results.size();
+
+        // Each thread counts its own errors, so that a check only sees the errors of its own thread
+        ErrorHandler::ScopedContext error_context;
+
+        if (m_synchronized_start)
+        {
+            // Spins rather than blocking, so that all threads start within a few instructions of each other
+            m_arrived_threads.fetch_add(1, std::memory_order_acq_rel);
+            std::int64_t timeout_nsec = get_ticks_nsec() + BARRIER_TIMEOUT_USEC * 1000;
+            while (m_arrived_threads.load(std::memory_order_acquire) < thread_count)
+            {
+                if (get_ticks_nsec() > timeout_nsec)
+                {
+                    result.barrier_timed_out = true;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+
+        std::int64_t running_threads = m_running_threads.fetch_add(1, std::memory_order_acq_rel) + 1;
+        std::int64_t peak_concurrency = m_peak_concurrency.load(std::memory_order_relaxed);
+        while (running_threads > peak_concurrency && !m_peak_concurrency.compare_exchange_weak(peak_concurrency, running_threads, std::memory_order_relaxed))
+        {
+        }
+
+        t_stress_tally = &result.tally;
+        result.start_nsec = get_ticks_nsec();
+        result.iterations = (*m_stress_thread)(thread_index, result.tally);
+        result.end_nsec = get_ticks_nsec();
+        t_stress_tally = nullptr;
+
+        m_running_threads.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    int StressTestCase::report_stress_run(const String& name, const char* file, int line, std::int64_t check_start_nsec, const StressRunStats& stats, double first_ops_per_second, std::int64_t first_thread_count)
+    {
+        StressTally total;
+        std::int64_t failing_threads = 0;
+        const StressThreadResult* first_failing_thread = nullptr;
+        for (const StressThreadResult& thread_result : m_thread_results)
+        {
+            total.passed += thread_result.tally.passed;
+            total.failed += thread_result.tally.failed;
+            total.errored += thread_result.tally.errored;
+            if (thread_result.tally.first_failure_iteration < 0)
+                continue;
+            failing_threads++;
+            if (first_failing_thread == nullptr)
+                first_failing_thread = &thread_result;
+        }
+
+        Dictionary results;
+        results["threads"] = stats.thread_count;
+        results["iterations"] = stats.iterations;
+        results["wall_nsec"] = stats.wall_nsec;
+        results["ops_per_second"] = stats.ops_per_second;
+        results["peak_concurrency"] = stats.peak_concurrency;
+        results["passed_checks"] = total.passed;
+        results["failed_checks"] = total.failed;
+        results["errored_checks"] = total.errored;
+        Array(m_stress_results[name]).push_back(results);
+
+        int check_result = total.errored > 0 ? CHECK_ERRORED : total.failed > 0 ? CHECK_FAILED : CHECK_PASSED;
+        return report_check("STRESS(NAME, BODY)", file, line, check_start_nsec, check_result, [&]()
+        {
+            print_output(vformat("        NAME: %s", name));
+            print_output(vformat("        threads: %s, iterations: %s (%s per thread)", stats.thread_count, stats.iterations, stats.iterations / stats.thread_count));
+            print_output(vformat("        time: %s, ops/sec: %.1f", format_nsec(stats.wall_nsec), stats.ops_per_second));
+            if (stats.thread_count != first_thread_count && first_ops_per_second > 0.0)
+            {
+                print_output(vformat("        scaling: %.2fx the ops/sec with %s", stats.ops_per_second / first_ops_per_second,
+                    first_thread_count == 1 ? String("1 thread") : vformat("%s threads", first_thread_count)));
+            }
+            if (stats.barrier_timed_out)
+                print_output(vformat("        only %s threads ran at the same time (the worker thread pool had too few free threads)", stats.peak_concurrency));
+            print_output(vformat("        checks: %s passed, %s failed, %s errored", total.passed, total.failed, total.errored));
+            if (first_failing_thread != nullptr)
+            {
+                const StressTally& tally = first_failing_thread->tally;
+                print_output(vformat("        first check that did not pass (thread %s, iteration %s): %s",
+                    std::int64_t(first_failing_thread - m_thread_results.data()), tally.first_failure_iteration, tally.first_failure));
+                for (std::int64_t i = 0; i < tally.first_failure_details.size(); ++i)
+                    print_output("    " + tally.first_failure_details[i]);
+                if (failing_threads > 1)
+                    print_output(vformat("        (%s threads had checks that did not pass)", failing_threads));
+            }
+        });
+    }
+
+    PackedInt32Array StressTestCase::get_thread_counts() const
+    {
+        return m_thread_counts;
+    }
+
+    void StressTestCase::set_thread_counts(const PackedInt32Array& thread_counts)
+    {
+        m_thread_counts = thread_counts;
+    }
+
+    std::int64_t StressTestCase::get_iterations() const
+    {
+        return m_iterations;
+    }
+
+    void StressTestCase::set_iterations(std::int64_t iterations)
+    {
+        m_iterations = iterations;
+    }
+
+    std::int64_t StressTestCase::get_stress_duration_usec() const
+    {
+        return m_stress_duration_usec;
+    }
+
+    void StressTestCase::set_stress_duration_usec(std::int64_t stress_duration_usec)
+    {
+        m_stress_duration_usec = stress_duration_usec;
+    }
+
+    bool StressTestCase::get_synchronized_start() const
+    {
+        return m_synchronized_start;
+    }
+
+    void StressTestCase::set_synchronized_start(bool synchronized_start)
+    {
+        m_synchronized_start = synchronized_start;
+    }
+
+    Dictionary StressTestCase::get_stress_results() const
+    {
+        return m_stress_results;
+    }
+
+    void StressTestCase::_bind_methods()
+    {
+        ClassDB::bind_method(D_METHOD("get_thread_counts"), &StressTestCase::get_thread_counts);
+        ClassDB::bind_method(D_METHOD("set_thread_counts", "thread_counts"), &StressTestCase::set_thread_counts);
+        ADD_PROPERTY(PropertyInfo(Variant::PACKED_INT32_ARRAY, "thread_counts"), "set_thread_counts", "get_thread_counts");
+
+        ClassDB::bind_method(D_METHOD("get_iterations"), &StressTestCase::get_iterations);
+        ClassDB::bind_method(D_METHOD("set_iterations", "iterations"), &StressTestCase::set_iterations);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "iterations"), "set_iterations", "get_iterations");
+
+        ClassDB::bind_method(D_METHOD("get_stress_duration_usec"), &StressTestCase::get_stress_duration_usec);
+        ClassDB::bind_method(D_METHOD("set_stress_duration_usec", "stress_duration_usec"), &StressTestCase::set_stress_duration_usec);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "stress_duration_usec"), "set_stress_duration_usec", "get_stress_duration_usec");
+
+        ClassDB::bind_method(D_METHOD("get_synchronized_start"), &StressTestCase::get_synchronized_start);
+        ClassDB::bind_method(D_METHOD("set_synchronized_start", "synchronized_start"), &StressTestCase::set_synchronized_start);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "synchronized_start"), "set_synchronized_start", "get_synchronized_start");
+
+        ClassDB::bind_method(D_METHOD("get_stress_results"), &StressTestCase::get_stress_results);
+        ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "stress_results", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_stress_results");
+    }
+}
@@ -0,0 +1,155 @@
+#ifndef STRESS_TEST_CASE_H
+#define STRESS_TEST_CASE_H
+
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "testing/test_case.h"
+
+namespace godot::Testing
+{
+    // What one thread of a stress test did, on a cache line of its own
+    struct alignas(64) StressThreadResult
+    {
+        StressTally tally;
+        std::int64_t iterations = 0;
+        std::int64_t start_nsec = 0;
+        std::int64_t end_nsec = 0;
+        // Whether the thread gave up waiting for the others at the start
+        bool barrier_timed_out = false;
+    };
+
+    // The results of running a stress test on one number of threads
+    struct StressRunStats
+    {
+        std::int64_t thread_count = 0;
+        std::int64_t iterations = 0;
+        // From the first thread starting its iterations to the last thread finishing them
+        double wall_nsec = 0.0;
+        double ops_per_second = 0.0;
+        // The most threads that were running their iterations at the same time
+        std::int64_t peak_concurrency = 0;
+        bool barrier_timed_out = false;
+    };
+
+    // A test case whose body can run code from several threads at once, to check that it is
+    // thread-safe and to measure how its throughput scales with the number of threads. Each
+    // STRESS(NAME, BODY) statement runs BODY on every thread count in thread_counts, through
+    // WorkerThreadPool, for iterations iterations per thread (or for stress_duration_usec, if
+    // set). Checks in BODY are counted per thread and reported as one check per thread count.
+    class StressTestCase : public TestCase
+    {
+        GDCLASS(StressTestCase, TestCase)
+
+    public:
+        using TestCase::TestCase;
+
+        PackedInt32Array get_thread_counts() const;
+        void set_thread_counts(const PackedInt32Array& thread_counts);
+
+        // The number of iterations each thread runs, unless stress_duration_usec is set
+        std::int64_t get_iterations() const;
+        void set_iterations(std::int64_t iterations);
+
+        // If set, each thread runs for this long instead of for a number of iterations
+        std::int64_t get_stress_duration_usec() const;
+        void set_stress_duration_usec(std::int64_t stress_duration_usec);
+
+        // If enabled, the threads wait for each other before starting, to maximize contention
+        bool get_synchronized_start() const;
+        void set_synchronized_start(bool synchronized_start);
+
+        Dictionary get_stress_results() const;
+
+    protected:
+        static void _bind_methods();
+
+        void begin_run() override;
+
+        // Runs the iterations of one thread, returning how many it ran
+        using StressThread = std::function<std::int64_t(std::int64_t thread_index, StressTally& tally)>;
+
+        // BODY can take no arguments, or the index of the thread and of the iteration
+        template <class Body>
+        int run_stress(const String& name, const char* file, int line, Body&& body)
+        {
+            using Clock = std::chrono::steady_clock;
+
+            return run_stress_threads(name, file, line, [&](std::int64_t thread_index, StressTally& tally) -> std::int64_t
+            {
+                auto run_iteration = [&](std::int64_t iteration)
+                {
+                    tally.iteration = iteration;
+                    if constexpr (std::is_invocable_v<Body&, std::int64_t, std::int64_t>)
+                        body(thread_index, iteration);
+                    else
+                        body();
+                };
+
+                std::int64_t iteration = 0;
+                if (m_stress_duration_usec > 0)
+                {
+                    // The clock is only read between batches, to keep it out of the measurement.
+                    // Batches start with one iteration and grow until they take about
+                    // CLOCK_READ_INTERVAL, so that threads with slow iterations still stop close
+                    // to the end.
+                    Clock::time_point batch_start = Clock::now();
+                    Clock::time_point end = batch_start + std::chrono::microseconds(m_stress_duration_usec);
+                    std::int64_t batch_size = 1;
+                    do
+                    {
+                        for (std::int64_t batch_end = iteration + batch_size; iteration < batch_end; ++iteration)
+                            run_iteration(iteration);
+
+                        Clock::time_point now = Clock::now();
+                        if (now - batch_start < CLOCK_READ_INTERVAL)
+                            batch_size = std::min(batch_size * 2, MAX_ITERATIONS_PER_CLOCK_READ);
+                        else if (now - batch_start > 2 * CLOCK_READ_INTERVAL)
+                            batch_size = std::max<std::int64_t>(batch_size / 2, 1);
+                        batch_start = now;
+                    }
+                    while (batch_start < end);
+                }
+                else
+                {
+                    for (; iteration < m_iterations; ++iteration)
+                        run_iteration(iteration);
+                }
+                return iteration;
+            });
+        }
+
+        int run_stress_threads(const String& name, const char* file, int line, const StressThread& stress_thread);
+        void run_stress_thread(std::uint32_t thread_index);
+        int report_stress_run(const String& name, const char* file, int line, std::int64_t check_start_nsec, const StressRunStats& stats, double first_ops_per_second, std::int64_t first_thread_count);
+
+        static constexpr std::chrono::microseconds CLOCK_READ_INTERVAL{10};
+        static constexpr std::int64_t MAX_ITERATIONS_PER_CLOCK_READ = 1 << 20;
+        // How long a thread waits for the others to start, in case the worker thread pool does
+        // not have enough free threads to run them all at once
+        static constexpr std::int64_t BARRIER_TIMEOUT_USEC = 1000000;
+
+        PackedInt32Array m_thread_counts = PackedInt32Array({1, 2, 4, 8});
+        std::int64_t m_iterations = 10000;
+        std::int64_t m_stress_duration_usec = 0;
+        bool m_synchronized_start = true;
+
+        Dictionary m_stress_results;
+
+        // The state of the thread count being run, shared with its threads
+        const StressThread* m_stress_thread = nullptr;
+        std::vector<StressThreadResult> m_thread_results;
+        std::atomic<std::int64_t> m_arrived_threads{0};
+        std::atomic<std::int64_t> m_running_threads{0};
+        std::atomic<std::int64_t> m_peak_concurrency{0};
+    };
+}
+
+#endif
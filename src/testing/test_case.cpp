@@ -1,13 +1,29 @@
 #include "test_case.h"
 
 #include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/time.hpp>
 
+#include "testing/snapshot.h"
 #include "testing/test_suite.h"
 
 namespace godot::Testing
 {
+    LeakSnapshot LeakSnapshot::take()
+    {
+        Performance* performance = Performance::get_singleton();
+        LeakSnapshot snapshot;
+        snapshot.objects = std::int64_t(performance->get_monitor(Performance::OBJECT_COUNT));
+        snapshot.orphan_nodes = std::int64_t(performance->get_monitor(Performance::OBJECT_ORPHAN_NODE_COUNT));
+        snapshot.static_memory = std::int64_t(performance->get_monitor(Performance::MEMORY_STATIC));
+        return snapshot;
+    }
+
     TestCase::TestCase(TestSuite* parent_test_suite) : m_parent_test_suite(parent_test_suite)
-    {}
+    {
+        m_output_sink.instantiate();
+        m_report.instantiate();
+    }
 
     TestSuite* TestCase::get_parent_test_suite() const
     {
@@ -19,19 +35,61 @@ namespace godot::Testing
         m_parent_test_suite = parent_test_suite;
     }
 
-    void TestCase::run()
+    void TestCase::run(bool flush_output)
+    {
+        begin_run();
+
+        {
+            // Errors reported while the test body runs are captured separately from other test cases
+            ErrorHandler::ScopedContext error_context;
+
+            bool check_leaks = m_check_leaks && s_leak_checks_enabled;
+            LeakSnapshot snapshot_before;
+            if (check_leaks)
+                snapshot_before = LeakSnapshot::take();
+
+            std::uint64_t start_usec = Time::get_singleton()->get_ticks_usec();
+            test_body();
+            m_duration_usec = Time::get_singleton()->get_ticks_usec() - start_usec;
+
+            if (check_leaks)
+                check_for_leaks(snapshot_before);
+        }
+
+        end_run(flush_output);
+    }
+
+    void TestCase::begin_run()
     {
-        UtilityFunctions::print_rich(LINE);
-        UtilityFunctions::print_rich(vformat("\n%s%s%s running...\n", TEST_NAME_START, this->get_class(), TEST_NAME_END));
+        s_running_test_cases.fetch_add(1, std::memory_order_relaxed);
+
+        print_output(LINE);
+        print_output(vformat("\n%s%s%s running...\n", TEST_NAME_START, this->get_class(), TEST_NAME_END));
 
         m_passed_checks = 0;
         m_failed_checks = 0;
         m_errored_checks = 0;
+        m_reported_failures = 0;
+        m_unreported_failures = 0;
 
-        test_body();
+        // A new report is created for every run, so that earlier reports stay intact
+        m_report.instantiate();
+        m_report->set_test_case_name(this->get_class());
+    }
+
+    void TestCase::end_run(bool flush_output)
+    {
+        s_running_test_cases.fetch_sub(1, std::memory_order_relaxed);
+
+        if (m_unreported_failures > 0)
+        {
+            print_output(vformat("    ...and %s more failing checks (not shown)", m_unreported_failures));
+            if (!m_suppress_details)
+                print_output("");
+        }
 
         if (m_suppress_details)
-            UtilityFunctions::print_rich("");
+            print_output("");
 
         String test_case_results;
         if (m_failed_checks == 0)
@@ -43,11 +101,150 @@ namespace godot::Testing
         if (m_errored_checks > 0)
             test_case_results += vformat(" %swith errors%s", ERRORED_START, ERRORED_END);
 
-        UtilityFunctions::print_rich(vformat("%s%s%s results: %s", TEST_NAME_START, this->get_class(), TEST_NAME_END, test_case_results));
-        UtilityFunctions::print_rich(vformat("    checks passed: %s%s%s", PASSED_START, m_passed_checks, PASSED_END));
-        UtilityFunctions::print_rich(vformat("    checks failed: %s%s%s", FAILED_START, m_failed_checks, FAILED_END));
-        UtilityFunctions::print_rich(vformat("    checks with unexpected errors: %s%s%s\n", ERRORED_START, m_errored_checks, ERRORED_END));
-        UtilityFunctions::print_rich(LINE);
+        print_output(vformat("%s%s%s results: %s", TEST_NAME_START, this->get_class(), TEST_NAME_END, test_case_results));
+        print_output(vformat("    checks passed: %s%s%s", PASSED_START, m_passed_checks, PASSED_END));
+        print_output(vformat("    checks failed: %s%s%s", FAILED_START, m_failed_checks, FAILED_END));
+        print_output(vformat("    checks with unexpected errors: %s%s%s\n", ERRORED_START, m_errored_checks, ERRORED_END));
+        print_output(LINE);
+
+        m_report->set_check_counts(m_passed_checks, m_failed_checks, m_errored_checks);
+        m_report->set_duration_usec(m_duration_usec);
+
+        for (std::int64_t i = 0; i < m_report_writers.size(); ++i)
+        {
+            Ref<ReportWriter> report_writer = m_report_writers[i];
+            if (report_writer.is_null())
+                continue;
+            report_writer->begin_test_suite(this->get_class());
+            report_writer->write_test_case(m_report);
+            report_writer->end_test_suite(m_duration_usec);
+        }
+
+        if (flush_output)
+            m_output_sink->flush();
+    }
+
+    void TestCase::check_for_leaks(const LeakSnapshot& snapshot_before)
+    {
+        LeakSnapshot snapshot_after = LeakSnapshot::take();
+        std::int64_t object_growth = snapshot_after.objects - snapshot_before.objects;
+        std::int64_t orphan_node_growth = snapshot_after.orphan_nodes - snapshot_before.orphan_nodes;
+        std::int64_t static_memory_growth = snapshot_after.static_memory - snapshot_before.static_memory;
+        if (object_growth <= 0 && orphan_node_growth <= 0 && static_memory_growth <= m_max_static_memory_growth)
+            return;
+
+        report_check("CHECK_NO_LEAKS(test_body())", __FILE__, __LINE__, start_check_timer(), CHECK_ERRORED, [&]()
+        {
+            print_output(vformat("        objects: %s -> %s (%+d)", snapshot_before.objects, snapshot_after.objects, object_growth));
+            print_output(vformat("        orphan nodes: %s -> %s (%+d)", snapshot_before.orphan_nodes, snapshot_after.orphan_nodes, orphan_node_growth));
+            print_output(vformat("        static memory: %s -> %s bytes (%+d, at most %s allowed)",
+                snapshot_before.static_memory, snapshot_after.static_memory, static_memory_growth, m_max_static_memory_growth));
+            print_output("        (disable check_leaks on the test case if this growth is expected)");
+        });
+    }
+
+    int TestCase::report_snapshot_check(const String& name, const char* file, int line, std::int64_t check_start_nsec, const Variant& value, std::int64_t error_count)
+    {
+        bool update_snapshots = m_update_snapshots || s_update_all_snapshots;
+        String path = m_snapshot_directory.path_join(this->get_class()).path_join(name + ".snapshot");
+
+        SnapshotComparison comparison;
+        if (error_count == 0)
+            comparison = compare_with_snapshot(value, path, update_snapshots);
+
+        int check_result;
+        if (error_count > 0 || comparison.status == SnapshotComparison::FILE_ERROR)
+            check_result = CHECK_ERRORED;
+        else if (comparison.status == SnapshotComparison::MATCHED || comparison.status == SnapshotComparison::UPDATED)
+            check_result = CHECK_PASSED;
+        else
+            check_result = CHECK_FAILED;
+
+        return report_check("CHECK_MATCHES_SNAPSHOT(EXPR, NAME)", file, line, check_start_nsec, check_result, [&]()
+        {
+            print_output(vformat("        NAME: %s", name));
+            print_output(vformat("        snapshot: %s", path));
+            if (error_count > 0)
+            {
+                _PRINT_ERRORED_DETAILS(error_count, get_last_n_errors);
+                return;
+            }
+
+            switch (comparison.status)
+            {
+                case SnapshotComparison::MATCHED:
+                    print_output(vformat("        matched (%s bytes, %s)", comparison.actual_size, comparison.compared_bytes ? "compared byte by byte" : "by hash"));
+                    break;
+                case SnapshotComparison::UPDATED:
+                    print_output(vformat("        snapshot updated (%s bytes)", comparison.actual_size));
+                    break;
+                case SnapshotComparison::MISSING:
+                    print_output("        no snapshot (run with update_snapshots to record one)");
+                    break;
+                case SnapshotComparison::FILE_ERROR:
+                    print_output(vformat("        could not access the snapshot: %s", UtilityFunctions::error_string(comparison.error)));
+                    break;
+                case SnapshotComparison::MISMATCHED:
+                    print_output(vformat("        sizes: %s bytes in the snapshot, %s bytes now", comparison.expected_size, comparison.actual_size));
+                    print_output(vformat("        first differing byte: %s", comparison.first_difference));
+                    print_output(vformat("        sha256: %s in the snapshot, %s now", comparison.expected_hash, comparison.actual_hash));
+                    for (std::int64_t i = 0; i < comparison.diff_lines.size(); ++i)
+                        print_output("        " + comparison.diff_lines[i]);
+                    break;
+            }
+        });
+    }
+
+    std::uint64_t TestCase::get_seed_for_property(const String& name) const
+    {
+        if (s_property_seed_override != 0)
+            return std::uint64_t(std::int64_t(s_property_seed_override));
+        if (m_property_seed != 0)
+            return std::uint64_t(m_property_seed);
+        // Fixed for each property, so that every run generates the same cases
+        return PropertyRandom::mix(String(this->get_class()).hash(), String(name).hash());
+    }
+
+    void TestCase::print_property_result(const String& name, const PropertyResult& result)
+    {
+        print_output(vformat("        NAME: %s", name));
+        if (result.passed)
+        {
+            print_output(vformat("        %s cases passed (seed %s)", result.cases_run, std::int64_t(result.seed)));
+            return;
+        }
+
+        print_output(vformat("        failed at case %s of %s (seed %s, case seed %s)", result.failing_case + 1, m_property_cases, std::int64_t(result.seed), std::int64_t(result.failing_case_seed)));
+        print_output(vformat("        arguments: %s", String(", ").join(result.original_arguments)));
+        print_output(vformat("        shrunk in %s steps to: %s", result.shrinks, String(", ").join(result.shrunk_arguments)));
+        print_output(vformat("        (replay with property_seed = %s, or --property-seed=%s)", std::int64_t(result.seed), std::int64_t(result.seed)));
+        if (result.error_count > 0)
+            _PRINT_ERRORED_DETAILS(result.error_count, get_last_n_errors);
+    }
+
+    void TestCase::print_output(const String& line)
+    {
+        if (t_captured_lines != nullptr)
+            t_captured_lines->push_back(line);
+        else if (m_print_results)
+            m_output_sink->print_line(line);
+    }
+
+    void TestCase::print_check_result(const char* check_string, int check_result, const PackedStringArray& details)
+    {
+        if (check_result == CHECK_PASSED)
+            print_output(vformat("    %s[PASSED]%s %s", PASSED_START, PASSED_END, check_string));
+        else if (check_result == CHECK_FAILED)
+            print_output(vformat("    %s[FAILED]%s %s", FAILED_START, FAILED_END, check_string));
+        else
+            print_output(vformat("    %s[ERRORED]%s %s", ERRORED_START, ERRORED_END, check_string));
+
+        if (!m_suppress_details)
+        {
+            for (std::int64_t i = 0; i < details.size(); ++i)
+                print_output(details[i]);
+            print_output("");
+        }
     }
 
     Callable TestCase::get_runner()
@@ -65,6 +262,166 @@ namespace godot::Testing
         m_suppress_details = suppress_details;
     }
 
+    bool TestCase::get_print_results() const
+    {
+        return m_print_results;
+    }
+
+    void TestCase::set_print_results(bool print_results)
+    {
+        m_print_results = print_results;
+    }
+
+    bool TestCase::get_capture_values() const
+    {
+        return m_capture_values;
+    }
+
+    void TestCase::set_capture_values(bool capture_values)
+    {
+        m_capture_values = capture_values;
+    }
+
+    bool TestCase::get_time_checks() const
+    {
+        return m_time_checks;
+    }
+
+    void TestCase::set_time_checks(bool time_checks)
+    {
+        m_time_checks = time_checks;
+    }
+
+    bool TestCase::get_fast_checks() const
+    {
+        return m_fast_checks;
+    }
+
+    void TestCase::set_fast_checks(bool fast_checks)
+    {
+        m_fast_checks = fast_checks;
+    }
+
+    std::int64_t TestCase::get_max_reported_failures() const
+    {
+        return m_max_reported_failures;
+    }
+
+    void TestCase::set_max_reported_failures(std::int64_t max_reported_failures)
+    {
+        m_max_reported_failures = max_reported_failures;
+    }
+
+    bool TestCase::get_check_leaks() const
+    {
+        return m_check_leaks;
+    }
+
+    void TestCase::set_check_leaks(bool check_leaks)
+    {
+        m_check_leaks = check_leaks;
+    }
+
+    void TestCase::set_leak_checks_enabled(bool leak_checks_enabled)
+    {
+        s_leak_checks_enabled = leak_checks_enabled;
+    }
+
+    bool TestCase::get_leak_checks_enabled()
+    {
+        return s_leak_checks_enabled;
+    }
+
+    std::int64_t TestCase::get_max_static_memory_growth() const
+    {
+        return m_max_static_memory_growth;
+    }
+
+    void TestCase::set_max_static_memory_growth(std::int64_t max_static_memory_growth)
+    {
+        m_max_static_memory_growth = max_static_memory_growth;
+    }
+
+    std::int64_t TestCase::get_property_cases() const
+    {
+        return m_property_cases;
+    }
+
+    void TestCase::set_property_cases(std::int64_t property_cases)
+    {
+        m_property_cases = property_cases;
+    }
+
+    std::int64_t TestCase::get_property_seed() const
+    {
+        return m_property_seed;
+    }
+
+    void TestCase::set_property_seed(std::int64_t property_seed)
+    {
+        m_property_seed = property_seed;
+    }
+
+    void TestCase::set_property_seed_override(std::int64_t property_seed_override)
+    {
+        s_property_seed_override = property_seed_override;
+    }
+
+    std::int64_t TestCase::get_property_seed_override()
+    {
+        return s_property_seed_override;
+    }
+
+    String TestCase::get_snapshot_directory() const
+    {
+        return m_snapshot_directory;
+    }
+
+    void TestCase::set_snapshot_directory(const String& snapshot_directory)
+    {
+        m_snapshot_directory = snapshot_directory;
+    }
+
+    bool TestCase::get_update_snapshots() const
+    {
+        return m_update_snapshots;
+    }
+
+    void TestCase::set_update_snapshots(bool update_snapshots)
+    {
+        m_update_snapshots = update_snapshots;
+    }
+
+    void TestCase::set_update_all_snapshots(bool update_all_snapshots)
+    {
+        s_update_all_snapshots = update_all_snapshots;
+    }
+
+    bool TestCase::get_update_all_snapshots()
+    {
+        return s_update_all_snapshots;
+    }
+
+    bool TestCase::get_thread_safe() const
+    {
+        return m_thread_safe;
+    }
+
+    void TestCase::set_thread_safe(bool thread_safe)
+    {
+        m_thread_safe = thread_safe;
+    }
+
+    Ref<OutputSink> TestCase::get_output_sink() const
+    {
+        return m_output_sink;
+    }
+
+    void TestCase::set_output_sink(const Ref<OutputSink>& output_sink)
+    {
+        m_output_sink = output_sink;
+    }
+
     std::int64_t TestCase::get_passed_checks() const
     {
         return m_passed_checks;
@@ -80,11 +437,32 @@ namespace godot::Testing
         return m_errored_checks;
     }
 
+    std::int64_t TestCase::get_duration_usec() const
+    {
+        return m_duration_usec;
+    }
+
+    Ref<TestReport> TestCase::get_report() const
+    {
+        return m_report;
+    }
+
+    TypedArray<ReportWriter> TestCase::get_report_writers() const
+    {
+        return m_report_writers;
+    }
+
+    void TestCase::set_report_writers(const TypedArray<ReportWriter>& report_writers)
+    {
+        m_report_writers = report_writers;
+    }
+
     void TestCase::_bind_methods()
     {
         ClassDB::bind_method(D_METHOD("get_parent_test_suite"), &TestCase::get_parent_test_suite);
 
-        ClassDB::bind_method(D_METHOD("run"), &TestCase::run);
+        ClassDB::bind_method(D_METHOD("run", "flush_output"), &TestCase::run, DEFVAL(true));
+        ClassDB::bind_method(D_METHOD("is_running"), &TestCase::is_running);
         ClassDB::bind_method(D_METHOD("get_runner"), &TestCase::get_runner);
         ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "runner", PROPERTY_HINT_TOOL_BUTTON, "Run test case,Play", PROPERTY_USAGE_EDITOR), "", "get_runner");
 
@@ -92,6 +470,66 @@ namespace godot::Testing
         ClassDB::bind_method(D_METHOD("set_suppress_details", "suppress_details"), &TestCase::set_suppress_details);
         ADD_PROPERTY(PropertyInfo(Variant::BOOL, "suppress_details"), "set_suppress_details", "get_suppress_details");
 
+        ClassDB::bind_method(D_METHOD("get_print_results"), &TestCase::get_print_results);
+        ClassDB::bind_method(D_METHOD("set_print_results", "print_results"), &TestCase::set_print_results);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "print_results"), "set_print_results", "get_print_results");
+
+        ClassDB::bind_method(D_METHOD("get_capture_values"), &TestCase::get_capture_values);
+        ClassDB::bind_method(D_METHOD("set_capture_values", "capture_values"), &TestCase::set_capture_values);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "capture_values"), "set_capture_values", "get_capture_values");
+
+        ClassDB::bind_method(D_METHOD("get_time_checks"), &TestCase::get_time_checks);
+        ClassDB::bind_method(D_METHOD("set_time_checks", "time_checks"), &TestCase::set_time_checks);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "time_checks"), "set_time_checks", "get_time_checks");
+
+        ClassDB::bind_method(D_METHOD("get_fast_checks"), &TestCase::get_fast_checks);
+        ClassDB::bind_method(D_METHOD("set_fast_checks", "fast_checks"), &TestCase::set_fast_checks);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "fast_checks"), "set_fast_checks", "get_fast_checks");
+
+        ClassDB::bind_method(D_METHOD("get_max_reported_failures"), &TestCase::get_max_reported_failures);
+        ClassDB::bind_method(D_METHOD("set_max_reported_failures", "max_reported_failures"), &TestCase::set_max_reported_failures);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "max_reported_failures", PROPERTY_HINT_RANGE, "0,1000,1,or_greater"), "set_max_reported_failures", "get_max_reported_failures");
+
+        ClassDB::bind_method(D_METHOD("get_thread_safe"), &TestCase::get_thread_safe);
+        ClassDB::bind_method(D_METHOD("set_thread_safe", "thread_safe"), &TestCase::set_thread_safe);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "thread_safe"), "set_thread_safe", "get_thread_safe");
+
+        ClassDB::bind_method(D_METHOD("get_check_leaks"), &TestCase::get_check_leaks);
+        ClassDB::bind_method(D_METHOD("set_check_leaks", "check_leaks"), &TestCase::set_check_leaks);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "check_leaks"), "set_check_leaks", "get_check_leaks");
+
+        ClassDB::bind_static_method("TestCase", D_METHOD("set_leak_checks_enabled", "leak_checks_enabled"), &TestCase::set_leak_checks_enabled);
+        ClassDB::bind_static_method("TestCase", D_METHOD("get_leak_checks_enabled"), &TestCase::get_leak_checks_enabled);
+
+        ClassDB::bind_method(D_METHOD("get_max_static_memory_growth"), &TestCase::get_max_static_memory_growth);
+        ClassDB::bind_method(D_METHOD("set_max_static_memory_growth", "max_static_memory_growth"), &TestCase::set_max_static_memory_growth);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "max_static_memory_growth", PROPERTY_HINT_RANGE, "0,1073741824,1,or_greater,suffix:B"), "set_max_static_memory_growth", "get_max_static_memory_growth");
+
+        ClassDB::bind_method(D_METHOD("get_snapshot_directory"), &TestCase::get_snapshot_directory);
+        ClassDB::bind_method(D_METHOD("set_snapshot_directory", "snapshot_directory"), &TestCase::set_snapshot_directory);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "snapshot_directory", PROPERTY_HINT_DIR), "set_snapshot_directory", "get_snapshot_directory");
+
+        ClassDB::bind_method(D_METHOD("get_update_snapshots"), &TestCase::get_update_snapshots);
+        ClassDB::bind_method(D_METHOD("set_update_snapshots", "update_snapshots"), &TestCase::set_update_snapshots);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "update_snapshots"), "set_update_snapshots", "get_update_snapshots");
+
+        ClassDB::bind_static_method("TestCase", D_METHOD("set_update_all_snapshots", "update_all_snapshots"), &TestCase::set_update_all_snapshots);
+        ClassDB::bind_static_method("TestCase", D_METHOD("get_update_all_snapshots"), &TestCase::get_update_all_snapshots);
+
+        ClassDB::bind_method(D_METHOD("get_property_cases"), &TestCase::get_property_cases);
+        ClassDB::bind_method(D_METHOD("set_property_cases", "property_cases"), &TestCase::set_property_cases);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "property_cases", PROPERTY_HINT_RANGE, "1,100000,1,or_greater"), "set_property_cases", "get_property_cases");
+
+        ClassDB::bind_method(D_METHOD("get_property_seed"), &TestCase::get_property_seed);
+        ClassDB::bind_method(D_METHOD("set_property_seed", "property_seed"), &TestCase::set_property_seed);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "property_seed"), "set_property_seed", "get_property_seed");
+
+        ClassDB::bind_static_method("TestCase", D_METHOD("set_property_seed_override", "property_seed_override"), &TestCase::set_property_seed_override);
+        ClassDB::bind_static_method("TestCase", D_METHOD("get_property_seed_override"), &TestCase::get_property_seed_override);
+
+        ClassDB::bind_method(D_METHOD("get_output_sink"), &TestCase::get_output_sink);
+        ClassDB::bind_method(D_METHOD("set_output_sink", "output_sink"), &TestCase::set_output_sink);
+
         ClassDB::bind_method(D_METHOD("get_passed_checks"), &TestCase::get_passed_checks);
         ADD_PROPERTY(PropertyInfo(Variant::INT, "passed_checks", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_passed_checks");
 
@@ -100,5 +538,15 @@ namespace godot::Testing
 
         ClassDB::bind_method(D_METHOD("get_errored_checks"), &TestCase::get_errored_checks);
         ADD_PROPERTY(PropertyInfo(Variant::INT, "errored_checks", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_errored_checks");
+
+        ClassDB::bind_method(D_METHOD("get_duration_usec"), &TestCase::get_duration_usec);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "duration_usec", PROPERTY_HINT_NONE, "suffix:us", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_duration_usec");
+
+        ClassDB::bind_method(D_METHOD("get_report"), &TestCase::get_report);
+        ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "report", PROPERTY_HINT_RESOURCE_TYPE, "TestReport", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_report");
+
+        ClassDB::bind_method(D_METHOD("get_report_writers"), &TestCase::get_report_writers);
+        ClassDB::bind_method(D_METHOD("set_report_writers", "report_writers"), &TestCase::set_report_writers);
+        ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "report_writers", PROPERTY_HINT_TYPE_STRING, vformat("%d/%d:ReportWriter", Variant::OBJECT, PROPERTY_HINT_RESOURCE_TYPE)), "set_report_writers", "get_report_writers");
     }
-}
\ No newline at end of file
+}
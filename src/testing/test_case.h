@@ -2,13 +2,48 @@
 #define TEST_CASE_H
 
 #include "godot_cpp/classes/resource.hpp"
+#include "godot_cpp/variant/typed_array.hpp"
 
+#include <atomic>
+#include <chrono>
+
+#include "testing/output_sink.h"
+#include "testing/property_testing.h"
+#include "testing/report_writer.h"
 #include "testing/test_macros.h"
+#include "testing/test_report.h"
 
 namespace godot::Testing
 {
     class TestSuite;
 
+    // Counts that grow when objects, orphan nodes, or memory are leaked
+    struct LeakSnapshot
+    {
+        std::int64_t objects = 0;
+        std::int64_t orphan_nodes = 0;
+        std::int64_t static_memory = 0;
+
+        static LeakSnapshot take();
+    };
+
+    // The checks made on one thread of a stress test, which are counted here instead of in the
+    // test case until the thread is done. Each tally has a cache line of its own, so that threads
+    // counting their checks do not contend.
+    struct alignas(64) StressTally
+    {
+        std::int64_t passed = 0;
+        std::int64_t failed = 0;
+        std::int64_t errored = 0;
+        // The iteration the thread is on, for describing the first check that did not pass
+        std::int64_t iteration = 0;
+
+        // Only the first check that did not pass is described, with its details
+        String first_failure;
+        std::int64_t first_failure_iteration = -1;
+        PackedStringArray first_failure_details;
+    };
+
     class TestCase : public Resource
     {
         GDCLASS(TestCase, Resource)
@@ -19,30 +54,292 @@ namespace godot::Testing
         TestSuite* get_parent_test_suite() const;
         void set_parent_test_suite(TestSuite* parent_test_suite);
 
-        void run();
+        virtual void run(bool flush_output = true);
+
+        // Whether the test case is still running (which only asynchronous test cases can be once run() returns)
+        virtual bool is_running() const { return false; }
 
         Callable get_runner();
 
         bool get_suppress_details() const;
         void set_suppress_details(bool suppress_details);
 
+        bool get_print_results() const;
+        void set_print_results(bool print_results);
+
+        bool get_capture_values() const;
+        void set_capture_values(bool capture_values);
+
+        bool get_time_checks() const;
+        void set_time_checks(bool time_checks);
+
+        bool get_fast_checks() const;
+        void set_fast_checks(bool fast_checks);
+
+        std::int64_t get_max_reported_failures() const;
+        void set_max_reported_failures(std::int64_t max_reported_failures);
+
+        bool get_thread_safe() const;
+        void set_thread_safe(bool thread_safe);
+
+        bool get_check_leaks() const;
+        void set_check_leaks(bool check_leaks);
+
+        // Leak checks only run while this is enabled, which the command-line runner does. In the
+        // editor and in watch mode, the engine creates objects of its own while test cases run.
+        static void set_leak_checks_enabled(bool leak_checks_enabled);
+        static bool get_leak_checks_enabled();
+
+        std::int64_t get_max_static_memory_growth() const;
+        void set_max_static_memory_growth(std::int64_t max_static_memory_growth);
+
+        String get_snapshot_directory() const;
+        void set_snapshot_directory(const String& snapshot_directory);
+
+        // If enabled, snapshot checks rewrite their snapshots with the new values and pass
+        bool get_update_snapshots() const;
+        void set_update_snapshots(bool update_snapshots);
+
+        // Makes every test case update its snapshots, as with update_snapshots
+        static void set_update_all_snapshots(bool update_all_snapshots);
+        static bool get_update_all_snapshots();
+
+        std::int64_t get_property_cases() const;
+        void set_property_cases(std::int64_t property_cases);
+
+        // Zero derives the seed of each property from the test case class and the property name
+        std::int64_t get_property_seed() const;
+        void set_property_seed(std::int64_t property_seed);
+
+        // Makes every property use this seed, for replaying a failure (zero to turn it off)
+        static void set_property_seed_override(std::int64_t property_seed_override);
+        static std::int64_t get_property_seed_override();
+
+        Ref<OutputSink> get_output_sink() const;
+        void set_output_sink(const Ref<OutputSink>& output_sink);
+
         std::int64_t get_passed_checks() const;
         std::int64_t get_failed_checks() const;
         std::int64_t get_errored_checks() const;
 
+        std::int64_t get_duration_usec() const;
+
+        Ref<TestReport> get_report() const;
+
+        TypedArray<ReportWriter> get_report_writers() const;
+        void set_report_writers(const TypedArray<ReportWriter>& report_writers);
+
     protected:
         static void _bind_methods();
 
         virtual void test_body() = 0;
 
+        // Print the header and the results of a run, respectively. Subclasses that keep results of
+        // their own reset them in begin_run().
+        virtual void begin_run();
+        void end_run(bool flush_output);
+
+        // Adds a line to the test case's output
+        void print_output(const String& line);
+
+        // Counts the result of a check, records it in the report (passing checks only if their values
+        // are captured or checks are timed), and prints it, followed by its details (unless they are
+        // suppressed). In fast mode, passing checks are only counted, and
+        // only the first m_max_reported_failures failing checks are recorded with details and
+        // printed. print_details is only called when the details are needed, so a passing check
+        // never formats its values unless they are captured.
+        //
+        // On the threads of a stress test, checks are only counted in the thread's tally, and only
+        // the details of the first check that did not pass are kept.
+        template <class PrintDetails>
+        int report_check(const char* check_string, const char* file, int line, std::int64_t check_start_nsec, int check_result, PrintDetails&& print_details, std::int64_t count = 1)
+        {
+            if (t_stress_tally != nullptr)
+            {
+                report_stress_check(*t_stress_tally, check_string, file, line, check_result, print_details, count);
+                return check_result;
+            }
+
+            std::int64_t duration_nsec = m_time_checks ? get_ticks_nsec() - check_start_nsec : 0;
+
+            if (check_result == CHECK_PASSED)
+                m_passed_checks += count;
+            else if (check_result == CHECK_FAILED)
+                m_failed_checks += count;
+            else
+                m_errored_checks += count;
+
+            bool print_check = m_print_results;
+            bool capture_details = check_result != CHECK_PASSED || m_capture_values;
+            if (m_fast_checks)
+            {
+                if (check_result == CHECK_PASSED)
+                    return check_result;
+                if (m_max_reported_failures > 0 && m_reported_failures >= m_max_reported_failures)
+                {
+                    m_unreported_failures++;
+                    print_check = false;
+                    capture_details = false;
+                }
+                else
+                {
+                    m_reported_failures++;
+                }
+            }
+
+            PackedStringArray details;
+            if (capture_details || (print_check && !m_suppress_details))
+            {
+                t_captured_lines = &details;
+                print_details();
+                t_captured_lines = nullptr;
+            }
+
+            // Passing checks are only counted, unless their values or durations are wanted, so that
+            // a long run does not keep a record of every check
+            if (check_result != CHECK_PASSED || m_capture_values || m_time_checks)
+                m_report->add_check(check_string, file, line, check_result, count, duration_nsec, capture_details ? String("\n").join(details) : String());
+            if (print_check)
+                print_check_result(check_string, check_result, details);
+            return check_result;
+        }
+
+        template <class PrintDetails>
+        static void report_stress_check(StressTally& tally, const char* check_string, const char* file, int line, int check_result, PrintDetails& print_details, std::int64_t count)
+        {
+            if (check_result == CHECK_PASSED)
+            {
+                tally.passed += count;
+                return;
+            }
+
+            if (check_result == CHECK_FAILED)
+                tally.failed += count;
+            else
+                tally.errored += count;
+
+            if (tally.first_failure_iteration < 0)
+            {
+                tally.first_failure = vformat("%s at %s:%s", check_string, file, line);
+                tally.first_failure_iteration = tally.iteration;
+                t_captured_lines = &tally.first_failure_details;
+                print_details();
+                t_captured_lines = nullptr;
+            }
+        }
+
+        // Whether process-wide counters, such as Godot's static memory usage, only change because of
+        // this test case: no other test case is in the middle of a run, and this is not a thread
+        // of a stress test
+        static bool is_only_running_test_case()
+        {
+            return s_running_test_cases.load(std::memory_order_relaxed) == 1 && t_stress_tally == nullptr;
+        }
+
+        // Returns the time at which a check starts, if checks are timed
+        std::int64_t start_check_timer() const
+        {
+            return m_time_checks ? get_ticks_nsec() : 0;
+        }
+
+        static std::int64_t get_ticks_nsec()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        void print_check_result(const char* check_string, int check_result, const PackedStringArray& details);
+
+        // Compares a value with the snapshot stored under name, in a directory for the test case class
+        int report_snapshot_check(const String& name, const char* file, int line, std::int64_t check_start_nsec, const Variant& value, std::int64_t error_count);
+
+        // Runs a property on property_cases generated cases as a single check, shrinking the
+        // arguments of the first failing case. Passing cases never format anything.
+        template <class... Generators, class Property>
+        int check_property(const String& name, const char* file, int line, const ForAll<Generators...>& for_all, Property&& property)
+        {
+            std::int64_t check_start_nsec = start_check_timer();
+
+            PropertySettings settings;
+            settings.cases = m_property_cases;
+            settings.seed = get_seed_for_property(name);
+            PropertyResult result = run_property(for_all, property, settings);
+
+            int check_result = result.passed ? CHECK_PASSED : result.error_count > 0 ? CHECK_ERRORED : CHECK_FAILED;
+            return report_check("CHECK_PROPERTY(NAME, GENERATORS, PROPERTY)", file, line, check_start_nsec, check_result, [&]()
+            {
+                print_property_result(name, result);
+            });
+        }
+
+        std::uint64_t get_seed_for_property(const String& name) const;
+        void print_property_result(const String& name, const PropertyResult& result);
+
+        // Reports an errored check if more objects, orphan nodes, or static memory (beyond
+        // m_max_static_memory_growth) exist than before the test body ran
+        void check_for_leaks(const LeakSnapshot& snapshot_before);
+
         TestSuite* m_parent_test_suite = nullptr;
 
         bool m_suppress_details = false;
 
+        // If disabled, nothing is printed, and the results are only available through the report
+        bool m_print_results = true;
+        // If enabled, the values of passing checks are recorded in the report too
+        bool m_capture_values = false;
+
+        // If enabled, the time each check takes (including evaluating its expressions) is recorded in the report
+        bool m_time_checks = false;
+
+        // In fast mode, passing checks are counted without being printed
+        bool m_fast_checks = false;
+        // Zero means that every failing check is printed
+        std::int64_t m_max_reported_failures = 10;
+        std::int64_t m_reported_failures = 0;
+        std::int64_t m_unreported_failures = 0;
+
+        // Thread-safe test cases may be run on a worker thread when their test suite runs in parallel
+        bool m_thread_safe = false;
+
+        // If enabled (and leak checks are enabled), the object count, orphan node count, and
+        // static memory usage are compared before and after the test body. These are
+        // process-wide, so test suites turn the check off for test cases that run at the same
+        // time as others.
+        bool m_check_leaks = true;
+
+        static inline std::atomic<bool> s_leak_checks_enabled{false};
+        // Static memory also grows with the output and report of the test case itself
+        std::int64_t m_max_static_memory_growth = 4 * 1024 * 1024;
+
+        // Meant to be checked in with the project
+        String m_snapshot_directory = "res://snapshots";
+        bool m_update_snapshots = false;
+
+        static inline std::atomic<bool> s_update_all_snapshots{false};
+
+        std::int64_t m_property_cases = 1000;
+        std::int64_t m_property_seed = 0;
+
+        static inline std::atomic<std::int64_t> s_property_seed_override{0};
+
+        Ref<OutputSink> m_output_sink;
+        // While set, print_output() on this thread adds lines here instead of to the output sink
+        static inline thread_local PackedStringArray* t_captured_lines = nullptr;
+        // Set on the threads of a stress test, whose checks are counted in their own tallies
+        static inline thread_local StressTally* t_stress_tally = nullptr;
+
+        // The number of test cases between begin_run() and end_run()
+        static inline std::atomic<std::int64_t> s_running_test_cases{0};
+
+        Ref<TestReport> m_report;
+        // Each run of the test case is written to these, as a test suite of its own
+        TypedArray<ReportWriter> m_report_writers;
+
         std::int64_t m_passed_checks = 0;
         std::int64_t m_failed_checks = 0;
         std::int64_t m_errored_checks = 0;
 
+        std::int64_t m_duration_usec = 0;
+
         Callable m_runner = Callable(this, "run");
 
         const String LINE = String("-").repeat(80);
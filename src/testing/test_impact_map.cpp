@@ -0,0 +1,295 @@
+#include "testing/test_impact_map.h"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/json.hpp>
+#include <godot_cpp/classes/os.hpp>
+
+#ifdef GDEXT_TESTING_COVERAGE
+// Provided by the gcov runtime (libgcov, or compiler-rt with Clang)
+extern "C" void __gcov_reset(void);
+extern "C" void __gcov_dump(void);
+#endif
+
+namespace godot::Testing
+{
+    static constexpr std::uint32_t GCDA_MAGIC = 0x67636461;
+    static constexpr std::uint32_t GCDA_ARC_COUNTERS_TAG = 0x01a10000;
+
+    static std::uint32_t read_u32(const PackedByteArray& bytes, std::int64_t offset)
+    {
+        const std::uint8_t* data = bytes.ptr() + offset;
+        return std::uint32_t(data[0]) | std::uint32_t(data[1]) << 8 | std::uint32_t(data[2]) << 16 | std::uint32_t(data[3]) << 24;
+    }
+
+    // Whether any arc counter in a .gcda file is non-zero, i.e. whether any code of its object
+    // file ran between the last reset and the dump
+    static bool has_executed_arcs(const PackedByteArray& bytes)
+    {
+        if (bytes.size() < 12 || read_u32(bytes, 0) != GCDA_MAGIC)
+            return false;
+
+        // Since GCC 12 (whose version starts with 'C'), record lengths are in bytes rather than
+        // words, the header has an extra checksum, and all-zero counters have a negative length
+        char major_version = char(read_u32(bytes, 4) >> 24);
+        bool lengths_in_bytes = major_version >= 'C' && major_version <= 'Z';
+        std::int64_t offset = lengths_in_bytes ? 16 : 12;
+
+        while (offset + 8 <= bytes.size())
+        {
+            std::uint32_t tag = read_u32(bytes, offset);
+            std::int32_t length = std::int32_t(read_u32(bytes, offset + 4));
+            offset += 8;
+            if (length <= 0)
+                continue;
+
+            std::int64_t length_in_bytes = lengths_in_bytes ? length : std::int64_t(length) * 4;
+            if (offset + length_in_bytes > bytes.size())
+                break;
+
+            if (tag == GCDA_ARC_COUNTERS_TAG)
+            {
+                for (std::int64_t i = 0; i < length_in_bytes; i += 4)
+                {
+                    if (read_u32(bytes, offset + i) != 0)
+                        return true;
+                }
+            }
+            offset += length_in_bytes;
+        }
+        return false;
+    }
+
+    static void find_files(const String& directory, const PackedStringArray& extensions, PackedStringArray& r_files)
+    {
+        PackedStringArray files = DirAccess::get_files_at(directory);
+        for (std::int64_t i = 0; i < files.size(); ++i)
+        {
+            if (extensions.has(files[i].get_extension()))
+                r_files.push_back(directory.path_join(files[i]));
+        }
+
+        PackedStringArray directories = DirAccess::get_directories_at(directory);
+        for (std::int64_t i = 0; i < directories.size(); ++i)
+            find_files(directory.path_join(directories[i]), extensions, r_files);
+    }
+
+    static void remove_directory(const String& directory)
+    {
+        if (!DirAccess::dir_exists_absolute(directory))
+            return;
+
+        PackedStringArray files = DirAccess::get_files_at(directory);
+        for (std::int64_t i = 0; i < files.size(); ++i)
+            DirAccess::remove_absolute(directory.path_join(files[i]));
+
+        PackedStringArray directories = DirAccess::get_directories_at(directory);
+        for (std::int64_t i = 0; i < directories.size(); ++i)
+            remove_directory(directory.path_join(directories[i]));
+
+        DirAccess::remove_absolute(directory);
+    }
+
+    bool TestImpactMap::is_recording_available()
+    {
+#ifdef GDEXT_TESTING_COVERAGE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool TestImpactMap::load(const String& path)
+    {
+        m_path = path;
+        m_test_cases.clear();
+        m_file_hashes.clear();
+        if (!FileAccess::file_exists(path))
+            return false;
+
+        Variant impact_map = JSON::parse_string(FileAccess::get_file_as_string(path));
+        if (impact_map.get_type() != Variant::DICTIONARY)
+            return false;
+
+        m_test_cases = Dictionary(impact_map).get("test_cases", Dictionary());
+        m_file_hashes = Dictionary(impact_map).get("files", Dictionary());
+        return true;
+    }
+
+    Error TestImpactMap::save()
+    {
+        // Hash the headers next to every covered source file, since their code is attributed to
+        // the source files that include them
+        PackedStringArray directories;
+        Array covered_sources = m_test_cases.values();
+        for (std::int64_t i = 0; i < covered_sources.size(); ++i)
+        {
+            PackedStringArray sources = covered_sources[i];
+            for (std::int64_t j = 0; j < sources.size(); ++j)
+            {
+                if (!directories.has(sources[j].get_base_dir()))
+                    directories.push_back(sources[j].get_base_dir());
+            }
+        }
+
+        PackedStringArray header_extensions = {"h", "hpp", "hh", "inl"};
+        for (std::int64_t i = 0; i < directories.size(); ++i)
+        {
+            PackedStringArray files = DirAccess::get_files_at(directories[i]);
+            for (std::int64_t j = 0; j < files.size(); ++j)
+            {
+                if (header_extensions.has(files[j].get_extension()))
+                {
+                    String header = directories[i].path_join(files[j]);
+                    m_file_hashes[header] = FileAccess::get_md5(header);
+                }
+            }
+        }
+
+        Ref<FileAccess> file = FileAccess::open(m_path, FileAccess::WRITE);
+        if (file.is_null())
+            return FileAccess::get_open_error();
+
+        Dictionary impact_map;
+        impact_map["test_cases"] = m_test_cases;
+        impact_map["files"] = m_file_hashes;
+        file->store_string(JSON::stringify(impact_map, "\t"));
+        return OK;
+    }
+
+    void TestImpactMap::begin_recording()
+    {
+#ifdef GDEXT_TESTING_COVERAGE
+        __gcov_reset();
+#endif
+    }
+
+    void TestImpactMap::end_recording(const String& key)
+    {
+#ifdef GDEXT_TESTING_COVERAGE
+        // The gcov runtime prefixes the absolute path of each .gcda file with GCOV_PREFIX, so each
+        // test case gets a fresh directory that only holds its own counters
+        OS* os = OS::get_singleton();
+        String dump_directory = os->get_user_data_dir().path_join("test_impact_dump");
+        remove_directory(dump_directory);
+        DirAccess::make_dir_recursive_absolute(dump_directory);
+
+        String previous_prefix = os->get_environment("GCOV_PREFIX");
+        os->set_environment("GCOV_PREFIX", dump_directory);
+        __gcov_dump();
+        if (previous_prefix.is_empty())
+            os->unset_environment("GCOV_PREFIX");
+        else
+            os->set_environment("GCOV_PREFIX", previous_prefix);
+
+        PackedStringArray sources = find_covered_sources(dump_directory);
+        remove_directory(dump_directory);
+
+        m_test_cases[key] = sources;
+        for (std::int64_t i = 0; i < sources.size(); ++i)
+            m_file_hashes[sources[i]] = FileAccess::get_md5(sources[i]);
+#else
+        ERR_FAIL_MSG("Recording test impact needs the extension to be built with coverage=yes.");
+#endif
+    }
+
+    PackedStringArray TestImpactMap::find_covered_sources(const String& dump_directory) const
+    {
+        PackedStringArray dump_files;
+        find_files(dump_directory, {"gcda"}, dump_files);
+
+        PackedStringArray source_extensions = {"cpp", "cc", "cxx", "c"};
+        PackedStringArray sources;
+        for (std::int64_t i = 0; i < dump_files.size(); ++i)
+        {
+            if (!has_executed_arcs(FileAccess::get_file_as_bytes(dump_files[i])))
+                continue;
+
+            // The object file (and so the .gcda file) is named after the source file, but may
+            // carry extra suffixes, such as "test_case.linux.template_debug.x86_64.gcda"
+            String object_path = dump_files[i].substr(dump_directory.length());
+            String stem = object_path.get_base_dir().path_join(object_path.get_file().get_slice(".", 0));
+            for (std::int64_t j = 0; j < source_extensions.size(); ++j)
+            {
+                String source = stem + "." + source_extensions[j];
+                if (FileAccess::file_exists(source))
+                {
+                    sources.push_back(source);
+                    break;
+                }
+            }
+        }
+        sources.sort();
+        return sources;
+    }
+
+    bool TestImpactMap::has_test_case(const String& key) const
+    {
+        return m_test_cases.has(key);
+    }
+
+    PackedStringArray TestImpactMap::get_covered_sources(const String& key) const
+    {
+        return m_test_cases.get(key, PackedStringArray());
+    }
+
+    PackedStringArray TestImpactMap::get_changed_files() const
+    {
+        PackedStringArray changed_files;
+        Array files = m_file_hashes.keys();
+        for (std::int64_t i = 0; i < files.size(); ++i)
+        {
+            String file = files[i];
+            if (!FileAccess::file_exists(file) || FileAccess::get_md5(file) != String(m_file_hashes[file]))
+                changed_files.push_back(file);
+        }
+        return changed_files;
+    }
+
+    bool TestImpactMap::is_affected(const String& key, const PackedStringArray& changed_files) const
+    {
+        if (!m_test_cases.has(key))
+            return true;
+
+        PackedStringArray covered_sources = m_test_cases[key];
+        for (std::int64_t i = 0; i < changed_files.size(); ++i)
+        {
+            if (covered_sources.has(changed_files[i]))
+                return true;
+
+            // A changed header may be included by any source file
+            String extension = changed_files[i].get_extension();
+            if (extension == "h" || extension == "hpp" || extension == "hh" || extension == "inl")
+                return true;
+        }
+        return false;
+    }
+
+    String TestImpactMap::get_path() const
+    {
+        return m_path;
+    }
+
+    void TestImpactMap::set_path(const String& path)
+    {
+        m_path = path;
+    }
+
+    void TestImpactMap::_bind_methods()
+    {
+        ClassDB::bind_static_method("TestImpactMap", D_METHOD("is_recording_available"), &TestImpactMap::is_recording_available);
+
+        ClassDB::bind_method(D_METHOD("load", "path"), &TestImpactMap::load);
+        ClassDB::bind_method(D_METHOD("save"), &TestImpactMap::save);
+        ClassDB::bind_method(D_METHOD("begin_recording"), &TestImpactMap::begin_recording);
+        ClassDB::bind_method(D_METHOD("end_recording", "key"), &TestImpactMap::end_recording);
+        ClassDB::bind_method(D_METHOD("has_test_case", "key"), &TestImpactMap::has_test_case);
+        ClassDB::bind_method(D_METHOD("get_covered_sources", "key"), &TestImpactMap::get_covered_sources);
+        ClassDB::bind_method(D_METHOD("get_changed_files"), &TestImpactMap::get_changed_files);
+        ClassDB::bind_method(D_METHOD("is_affected", "key", "changed_files"), &TestImpactMap::is_affected);
+
+        ClassDB::bind_method(D_METHOD("get_path"), &TestImpactMap::get_path);
+        ClassDB::bind_method(D_METHOD("set_path", "path"), &TestImpactMap::set_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "path", PROPERTY_HINT_SAVE_FILE, "*.json"), "set_path", "get_path");
+    }
+}
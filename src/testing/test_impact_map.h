@@ -0,0 +1,61 @@
+#ifndef TEST_IMPACT_MAP_H
+#define TEST_IMPACT_MAP_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+
+namespace godot::Testing
+{
+    // Remembers which source files each test case executed, so that a later run can skip the test
+    // cases whose sources have not changed. Recording needs an extension built with
+    // "scons coverage=yes": the gcov counters are reset before each test case and dumped after it,
+    // and every object file with a non-zero counter marks its source file as covered.
+    //
+    // Code in headers is counted towards the source files that include it, so the map also keeps
+    // the hashes of the headers next to the covered sources, and a changed header makes every test
+    // case count as affected.
+    class TestImpactMap : public RefCounted
+    {
+        GDCLASS(TestImpactMap, RefCounted)
+
+    public:
+        static constexpr const char* DEFAULT_PATH = "user://test_impact.json";
+
+        // Whether this build of the extension can record coverage
+        static bool is_recording_available();
+
+        // Returns false (and leaves the map empty) if the file does not exist or cannot be parsed
+        bool load(const String& path);
+        Error save();
+
+        // Must bracket a test case that runs alone, since the coverage counters are process-wide
+        void begin_recording();
+        void end_recording(const String& key);
+
+        bool has_test_case(const String& key) const;
+        PackedStringArray get_covered_sources(const String& key) const;
+
+        // The recorded source and header files whose contents have changed since they were recorded
+        PackedStringArray get_changed_files() const;
+        // Whether a test case must run given the changed files (true if it has no entry)
+        bool is_affected(const String& key, const PackedStringArray& changed_files) const;
+
+        String get_path() const;
+        void set_path(const String& path);
+
+    protected:
+        static void _bind_methods();
+
+    private:
+        PackedStringArray find_covered_sources(const String& dump_directory) const;
+
+        String m_path = DEFAULT_PATH;
+        // Test case key to the source files it covered
+        Dictionary m_test_cases;
+        // Source or header file to the MD5 of its contents when it was last recorded
+        Dictionary m_file_hashes;
+    };
+}
+
+#endif
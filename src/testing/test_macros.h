@@ -3,6 +3,9 @@
 
 #include <algorithm>
 
+#include "testing/allocation_counter.h"
+#include "testing/array_comparison.h"
+#include "testing/container_diff.h"
 #include "testing/error_handler.h"
 
 // Macros defining commonly used strings
@@ -20,13 +23,14 @@
 
 // Macros for setting up test cases within a test suite
 
-#define DECLARE_TEST_CASE(TestCaseName, test_case_name) \
+#define _DECLARE_TEST_CASE(TestCaseName, test_case_name, TestCaseBaseName) \
     public: \
-        class TestCaseName : public godot::Testing::TestCase \
+        class TestCaseName : public TestCaseBaseName \
         { \
-            GDCLASS(TestCaseName, godot::Testing::TestCase) \
+            GDCLASS(TestCaseName, TestCaseBaseName) \
         public: \
-            using godot::Testing::TestCase::TestCase; \
+            using TestCaseBase = TestCaseBaseName; \
+            using TestCaseBase::TestCaseBase; \
         protected: \
             virtual void test_body() override; \
             static void _bind_methods() {} \
@@ -37,6 +41,14 @@
         Ref<TestCaseName> m_ ## test_case_name; \
     public:
 
+#define DECLARE_TEST_CASE(TestCaseName, test_case_name) _DECLARE_TEST_CASE(TestCaseName, test_case_name, godot::Testing::TestCase)
+
+#define DECLARE_BENCHMARK_CASE(TestCaseName, test_case_name) _DECLARE_TEST_CASE(TestCaseName, test_case_name, godot::Testing::BenchmarkCase)
+
+#define DECLARE_ASYNC_TEST_CASE(TestCaseName, test_case_name) _DECLARE_TEST_CASE(TestCaseName, test_case_name, godot::Testing::AsyncTestCase)
+
+#define DECLARE_STRESS_TEST_CASE(TestCaseName, test_case_name) _DECLARE_TEST_CASE(TestCaseName, test_case_name, godot::Testing::StressTestCase)
+
 #define REGISTER_TEST_CASE(TestCaseName, test_case_name) \
     m_all_test_cases.push_back({#test_case_name, m_ ## test_case_name});
 
@@ -73,6 +85,12 @@
     } \
     void TestSuiteName::TestCaseName::test_body()
 
+#define DEFINE_BENCHMARK_CASE(TestSuiteName, TestCaseName, test_case_name) DEFINE_TEST_CASE(TestSuiteName, TestCaseName, test_case_name)
+
+#define DEFINE_ASYNC_TEST_CASE(TestSuiteName, TestCaseName, test_case_name) DEFINE_TEST_CASE(TestSuiteName, TestCaseName, test_case_name)
+
+#define DEFINE_STRESS_TEST_CASE(TestSuiteName, TestCaseName, test_case_name) DEFINE_TEST_CASE(TestSuiteName, TestCaseName, test_case_name)
+
 // Macros defining common return values for checks
 
 #define CHECK_PASSED 1
@@ -81,46 +99,23 @@
 
 // Macros for manually passing a check
 
-#define _PRINT_PASSED(check_string) \
-    UtilityFunctions::print_rich(vformat("    %s[PASSED]%s %s", PASSED_START, PASSED_END, check_string)); \
-
-#define _PRINT_FAILED(check_string) \
-    UtilityFunctions::print_rich(vformat("    %s[FAILED]%s %s", FAILED_START, FAILED_END, check_string)); \
-
-#define _PRINT_ERRORED(check_string) \
-    UtilityFunctions::print_rich(vformat("    %s[ERRORED]%s %s", ERRORED_START, ERRORED_END, check_string)); \
-
-#define _CHECK_PASS_FAIL_CUSTOM(COUNT, MESSAGE, PASS_OR_FAIL, passed_or_failed_checks, check_result) \
-    [&]() -> int \
+#define _CHECK_PASS_FAIL_CUSTOM(COUNT, MESSAGE, PASS_OR_FAIL, check_result) \
+    report_check("CHECK_" #PASS_OR_FAIL "_CUSTOM(COUNT, MESSAGE)", __FILE__, __LINE__, start_check_timer(), check_result, [&]() \
     { \
-        _PRINT_ ## PASS_OR_FAIL ## ED(vformat("CHECK_%s_CUSTOM(COUNT, MESSAGE)", #PASS_OR_FAIL)); \
-        if (!m_suppress_details) \
-        { \
-            UtilityFunctions::print_rich(vformat("        COUNT: %s", COUNT)); \
-            UtilityFunctions::print_rich(vformat("        MESSAGE: %s", MESSAGE)); \
-            UtilityFunctions::print_rich(""); \
-        } \
-        passed_or_failed_checks += COUNT; \
-        return check_result; \
-    }()
+        print_output(vformat("        COUNT: %s", COUNT)); \
+        print_output(vformat("        MESSAGE: %s", MESSAGE)); \
+    }, COUNT)
 
-#define CHECK_PASS_CUSTOM(COUNT, MESSAGE) _CHECK_PASS_FAIL_CUSTOM(COUNT, MESSAGE, PASS, m_passed_checks, CHECK_PASSED)
+#define CHECK_PASS_CUSTOM(COUNT, MESSAGE) _CHECK_PASS_FAIL_CUSTOM(COUNT, MESSAGE, PASS, CHECK_PASSED)
 
-#define CHECK_FAIL_CUSTOM(COUNT, MESSAGE) _CHECK_PASS_FAIL_CUSTOM(COUNT, MESSAGE, FAIL, m_failed_checks, CHECK_FAILED)
+#define CHECK_FAIL_CUSTOM(COUNT, MESSAGE) _CHECK_PASS_FAIL_CUSTOM(COUNT, MESSAGE, FAIL, CHECK_FAILED)
 
-#define _CHECK_PASS_FAIL(PASS_OR_FAIL, passed_or_failed_checks, check_result) \
-    [&]() -> int \
-    { \
-        UtilityFunctions::print_rich(vformat("    %s[%sED]%s CHECK_%s()", PASS_OR_FAIL ## ED_START, #PASS_OR_FAIL, PASS_OR_FAIL ## ED_END, #PASS_OR_FAIL)); \
-        if (!m_suppress_details) \
-            UtilityFunctions::print_rich(""); \
-        passed_or_failed_checks++; \
-        return check_result; \
-    }()
+#define _CHECK_PASS_FAIL(PASS_OR_FAIL, check_result) \
+    report_check("CHECK_" #PASS_OR_FAIL "()", __FILE__, __LINE__, start_check_timer(), check_result, []() {})
 
-#define CHECK_PASS() _CHECK_PASS_FAIL(PASS, m_passed_checks, CHECK_PASSED)
+#define CHECK_PASS() _CHECK_PASS_FAIL(PASS, CHECK_PASSED)
 
-#define CHECK_FAIL() _CHECK_PASS_FAIL(FAIL, m_failed_checks, CHECK_FAILED)
+#define CHECK_FAIL() _CHECK_PASS_FAIL(FAIL, CHECK_FAILED)
 
 // Macros for checking for the existence (or non-existence) of errors
 
@@ -130,47 +125,28 @@
         PackedStringArray error_messages = ErrorHandler::get_last_n_function(error_count); \
         if (error_messages.size() == 1) \
         { \
-            UtilityFunctions::print_rich(vformat("        error: %s", error_messages[0])); \
+            print_output(vformat("        error: %s", error_messages[0])); \
         } \
         else if (error_messages.size() > 1) \
         { \
-            UtilityFunctions::print_rich("        errors:"); \
+            print_output("        errors:"); \
             for (std::int64_t i = 0; i < error_messages.size(); ++i) \
-                UtilityFunctions::print_rich(vformat("            %s", error_messages[i])); \
+                print_output(vformat("            %s", error_messages[i])); \
         } \
     }()
 
 #define _CHECK_ERRORS(EXPR, count_comparison_operator, count_comparison_value, check_string, ERROR_MACRO_SUFFIX, get_last_n_function) \
     [&]() -> int \
     { \
+        std::int64_t check_start_nsec = start_check_timer(); \
         std::int64_t count = 0; \
         SUPPRESS_AND_COUNT_ ## ERROR_MACRO_SUFFIX(EXPR, count); \
-        int check_result; \
-        if (count count_comparison_operator count_comparison_value) \
-        { \
-            _PRINT_PASSED(check_string); \
-            if (!m_suppress_details) \
-            { \
-                UtilityFunctions::print_rich(vformat("        EXPR code: %s", #EXPR)); \
-                _PRINT_ERRORED_DETAILS(count, get_last_n_function); \
-            } \
-            m_passed_checks++; \
-            check_result = CHECK_PASSED; \
-        } \
-        else \
+        int check_result = (count count_comparison_operator count_comparison_value) ? CHECK_PASSED : CHECK_FAILED; \
+        return report_check(check_string, __FILE__, __LINE__, check_start_nsec, check_result, [&]() \
         { \
-            _PRINT_FAILED(check_string); \
-            if (!m_suppress_details) \
-            { \
-                UtilityFunctions::print_rich(vformat("        EXPR code: %s", #EXPR)); \
-                _PRINT_ERRORED_DETAILS(count, get_last_n_function); \
-            } \
-            m_failed_checks++; \
-            check_result = CHECK_FAILED; \
-        } \
-        if (!m_suppress_details) \
-            UtilityFunctions::print_rich(""); \
-        return check_result; \
+            print_output(vformat("        EXPR code: %s", #EXPR)); \
+            _PRINT_ERRORED_DETAILS(count, get_last_n_function); \
+        }); \
     }()
 
 #define CHECK_N_ERRORS(EXPR, N) _CHECK_ERRORS(EXPR, ==, N, "CHECK_N_ERRORS(EXPR, N)", ALL_ERRORS, get_last_n_errors)
@@ -197,56 +173,78 @@
 
 #define CHECK_NO_PUSH_WARNINGS(EXPR) _CHECK_ERRORS(EXPR, <=, 0, "CHECK_NO_PUSH_WARNINGS(EXPR)", PUSH_WARNING, get_last_n_push_warnings)
 
+// Macros for checking how many heap allocations evaluating an expression makes. Allocations made
+// by this library are counted in builds with allocation_hooks=yes. Allocations made through
+// Godot's allocator (String, Array, packed arrays, memnew) are seen as growth of Godot's static
+// memory usage while the result of the expression is alive, which counts as (at least) one
+// allocation, but only while no other test case is running. A check that can measure neither, or
+// that needs an exact count (more than zero) without the hooks, is reported as errored.
+
+#define _CHECK_ALLOCATIONS(EXPR, MAX_ALLOCATIONS, check_string) \
+    [&]() -> int \
+    { \
+        std::int64_t check_start_nsec = start_check_timer(); \
+        std::int64_t error_count = 0; \
+        godot::Testing::AllocationCounts allocation_counts; \
+        SUPPRESS_AND_COUNT_ALL_ERRORS(allocation_counts = godot::Testing::count_allocations([&]() -> decltype(auto) { return EXPR; }), error_count); \
+        std::int64_t max_allocations = MAX_ALLOCATIONS; \
+        bool counting_available = godot::Testing::is_allocation_counting_available(); \
+        bool static_memory_measured = godot::Testing::is_static_memory_tracked() && is_only_running_test_case(); \
+        bool godot_allocated = static_memory_measured && allocation_counts.static_memory_change > 0; \
+        std::int64_t allocations = allocation_counts.allocations + (godot_allocated ? 1 : 0); \
+        bool measurable = counting_available || (static_memory_measured && max_allocations == 0); \
+        int check_result = error_count > 0 || !measurable ? CHECK_ERRORED : allocations <= max_allocations ? CHECK_PASSED : CHECK_FAILED; \
+        return report_check(check_string, __FILE__, __LINE__, check_start_nsec, check_result, [&]() \
+        { \
+            print_output(vformat("        EXPR code: %s", #EXPR)); \
+            if (counting_available) \
+            { \
+                print_output(vformat("        allocations: %s (at most %s)", allocations, max_allocations)); \
+                print_output(vformat("        bytes allocated by this library: %s", allocation_counts.bytes)); \
+            } \
+            else \
+            { \
+                print_output("        allocations by this library: not counted (build with allocation_hooks=yes)"); \
+            } \
+            if (static_memory_measured) \
+                print_output(vformat("        Godot static memory change: %s bytes%s", allocation_counts.static_memory_change, godot_allocated ? " (counted as an allocation)" : "")); \
+            else \
+                print_output("        Godot static memory change: not measured (release build of Godot, or other test cases were running)"); \
+            if (error_count > 0) \
+                _PRINT_ERRORED_DETAILS(error_count, get_last_n_errors); \
+        }); \
+    }()
+
+#define CHECK_MAX_ALLOCATIONS(EXPR, N) _CHECK_ALLOCATIONS(EXPR, N, "CHECK_MAX_ALLOCATIONS(EXPR, N)")
+
+#define CHECK_NO_ALLOCATIONS(EXPR) _CHECK_ALLOCATIONS(EXPR, 0, "CHECK_NO_ALLOCATIONS(EXPR)")
+
 // Macros for checking if an expression is true or false
 
 #define _PRINT_CODE_AND_VALUE(EXPR, expr_string, expr_value) \
     [&]() \
     { \
-        UtilityFunctions::print_rich(vformat("        %s code: %s", expr_string, #EXPR)); \
-        UtilityFunctions::print_rich(vformat("        %s value: %s", expr_string, godot::Testing::to_string(expr_value))); \
+        print_output(vformat("        %s code: %s", expr_string, #EXPR)); \
+        print_output(vformat("        %s value: %s", expr_string, godot::Testing::to_string(expr_value))); \
     }()
 
 #define _CHECK_BOOL(EXPR, not_operator, TRUE_OR_FALSE) \
     [&]() -> int \
     { \
-        String check_string = vformat("CHECK_%s(EXPR)", #TRUE_OR_FALSE); \
+        std::int64_t check_start_nsec = start_check_timer(); \
         auto suppress_all = ErrorHandler::get_suppress_all(); \
         ErrorHandler::set_suppress_all({true, true, true}); \
         std::int64_t previous_error_count = ErrorHandler::get_total_count(); \
         auto expr_value = EXPR; \
         std::int64_t error_count = ErrorHandler::get_total_count() - previous_error_count; \
         ErrorHandler::set_suppress_all(suppress_all); \
-        int check_result; \
-        if (error_count > 0) \
+        int check_result = error_count > 0 ? CHECK_ERRORED : not_operator(expr_value) ? CHECK_PASSED : CHECK_FAILED; \
+        return report_check("CHECK_" #TRUE_OR_FALSE "(EXPR)", __FILE__, __LINE__, check_start_nsec, check_result, [&]() \
         { \
-            _PRINT_ERRORED(check_string); \
-            if (!m_suppress_details) \
-            { \
-                _PRINT_CODE_AND_VALUE(EXPR, "EXPR", expr_value); \
+            _PRINT_CODE_AND_VALUE(EXPR, "EXPR", expr_value); \
+            if (check_result == CHECK_ERRORED) \
                 _PRINT_ERRORED_DETAILS(error_count, get_last_n_errors); \
-            } \
-            m_errored_checks++; \
-            check_result = CHECK_ERRORED; \
-        } \
-        else if (not_operator(expr_value)) \
-        { \
-            _PRINT_PASSED(check_string); \
-            if (!m_suppress_details) \
-                _PRINT_CODE_AND_VALUE(EXPR, "EXPR", expr_value); \
-            m_passed_checks++; \
-            check_result = CHECK_PASSED; \
-        } \
-        else \
-        { \
-            _PRINT_FAILED(check_string); \
-            if (!m_suppress_details) \
-                _PRINT_CODE_AND_VALUE(EXPR, "EXPR", expr_value); \
-            m_failed_checks++; \
-            check_result = CHECK_FAILED; \
-        } \
-        if (!m_suppress_details) \
-            UtilityFunctions::print_rich(""); \
-        return check_result; \
+        }); \
     }()
 
 #define CHECK_TRUE(EXPR) _CHECK_BOOL(EXPR, , TRUE)
@@ -266,7 +264,7 @@
 #define _CHECK_COMPARE(EXPR_A, EXPR_B, COMPARE) \
     [&]() -> int \
     { \
-        String check_string = vformat("CHECK_%s(EXPR_A, EXPR_B)", #COMPARE); \
+        std::int64_t check_start_nsec = start_check_timer(); \
         auto suppress_all = ErrorHandler::get_suppress_all(); \
         ErrorHandler::set_suppress_all({true, true, true}); \
         std::int64_t previous_error_count = ErrorHandler::get_total_count(); \
@@ -274,44 +272,14 @@
         auto expr_b_value = EXPR_B; \
         std::int64_t error_count = ErrorHandler::get_total_count() - previous_error_count; \
         ErrorHandler::set_suppress_all(suppress_all); \
-        int check_result; \
-        if (error_count > 0) \
+        int check_result = error_count > 0 ? CHECK_ERRORED : (_ ## COMPARE(expr_a_value, expr_b_value)) ? CHECK_PASSED : CHECK_FAILED; \
+        return report_check("CHECK_" #COMPARE "(EXPR_A, EXPR_B)", __FILE__, __LINE__, check_start_nsec, check_result, [&]() \
         { \
-            _PRINT_ERRORED(check_string); \
-            if (!m_suppress_details) \
-            { \
-                _PRINT_CODE_AND_VALUE(EXPR_A, "EXPR_A", expr_a_value); \
-                _PRINT_CODE_AND_VALUE(EXPR_B, "EXPR_B", expr_b_value); \
+            _PRINT_CODE_AND_VALUE(EXPR_A, "EXPR_A", expr_a_value); \
+            _PRINT_CODE_AND_VALUE(EXPR_B, "EXPR_B", expr_b_value); \
+            if (check_result == CHECK_ERRORED) \
                 _PRINT_ERRORED_DETAILS(error_count, get_last_n_errors); \
-            } \
-            m_errored_checks++; \
-            check_result = CHECK_ERRORED; \
-        } \
-        else if (_ ## COMPARE(expr_a_value, expr_b_value)) \
-        { \
-            _PRINT_PASSED(check_string); \
-            if (!m_suppress_details) \
-            { \
-                _PRINT_CODE_AND_VALUE(EXPR_A, "EXPR_A", expr_a_value); \
-                _PRINT_CODE_AND_VALUE(EXPR_B, "EXPR_B", expr_b_value); \
-            } \
-            m_passed_checks++; \
-            check_result = CHECK_PASSED; \
-        } \
-        else \
-        { \
-            _PRINT_FAILED(check_string); \
-            if (!m_suppress_details) \
-            { \
-                _PRINT_CODE_AND_VALUE(EXPR_A, "EXPR_A", expr_a_value); \
-                _PRINT_CODE_AND_VALUE(EXPR_B, "EXPR_B", expr_b_value); \
-            } \
-            m_failed_checks++; \
-            check_result = CHECK_ERRORED; \
-        } \
-        if (!m_suppress_details) \
-            UtilityFunctions::print_rich(""); \
-        return check_result; \
+        }); \
     }()
 
 #define CHECK_EQUAL(EXPR_A, EXPR_B) _CHECK_COMPARE(EXPR_A, EXPR_B, EQUAL)
@@ -328,4 +296,95 @@
 
 #define CHECK_APPROX_EQUAL(EXPR_A, EXPR_B) _CHECK_COMPARE(EXPR_A, EXPR_B, APPROX_EQUAL)
 
+// Compares two values like CHECK_EQUAL, but when they differ, only prints a summary of the
+// differences between them instead of both full values
+
+#define CHECK_CONTAINERS_EQUAL(EXPR_A, EXPR_B) \
+    [&]() -> int \
+    { \
+        std::int64_t check_start_nsec = start_check_timer(); \
+        auto suppress_all = ErrorHandler::get_suppress_all(); \
+        ErrorHandler::set_suppress_all({true, true, true}); \
+        std::int64_t previous_error_count = ErrorHandler::get_total_count(); \
+        Variant expr_a_value = EXPR_A; \
+        Variant expr_b_value = EXPR_B; \
+        std::int64_t error_count = ErrorHandler::get_total_count() - previous_error_count; \
+        ErrorHandler::set_suppress_all(suppress_all); \
+        int check_result = error_count > 0 ? CHECK_ERRORED : godot::Testing::containers_equal(expr_a_value, expr_b_value) ? CHECK_PASSED : CHECK_FAILED; \
+        return report_check("CHECK_CONTAINERS_EQUAL(EXPR_A, EXPR_B)", __FILE__, __LINE__, check_start_nsec, check_result, [&]() \
+        { \
+            print_output(vformat("        EXPR_A code: %s", #EXPR_A)); \
+            print_output(vformat("        EXPR_B code: %s", #EXPR_B)); \
+            PackedStringArray diff_lines = godot::Testing::diff_containers(expr_a_value, expr_b_value); \
+            for (std::int64_t i = 0; i < diff_lines.size(); ++i) \
+                print_output("        " + diff_lines[i]); \
+            if (check_result == CHECK_ERRORED) \
+                _PRINT_ERRORED_DETAILS(error_count, get_last_n_errors); \
+        }); \
+    }()
+
+// Compares the serialized value of an expression with the snapshot stored under NAME (see
+// TestCase::report_snapshot_check)
+
+#define CHECK_MATCHES_SNAPSHOT(EXPR, NAME) \
+    [&]() -> int \
+    { \
+        std::int64_t check_start_nsec = start_check_timer(); \
+        std::int64_t error_count = 0; \
+        Variant expr_value; \
+        SUPPRESS_AND_COUNT_ALL_ERRORS(expr_value = EXPR, error_count); \
+        return report_snapshot_check(NAME, __FILE__, __LINE__, check_start_nsec, expr_value, error_count); \
+    }()
+
+// Checks that PROPERTY (a callable returning bool) holds for arguments made by GENERATORS, such
+// as Testing::for_all(Testing::Generate::integers(), Testing::Generate::strings())
+
+#define CHECK_PROPERTY(NAME, GENERATORS, ...) check_property(NAME, __FILE__, __LINE__, GENERATORS, __VA_ARGS__)
+
+// Macros for comparing whole packed arrays at once
+
+#define _CHECK_ARRAYS(EXPR_A, EXPR_B, TOLERANCE, check_string) \
+    [&]() -> int \
+    { \
+        std::int64_t check_start_nsec = start_check_timer(); \
+        auto suppress_all = ErrorHandler::get_suppress_all(); \
+        ErrorHandler::set_suppress_all({true, true, true}); \
+        std::int64_t previous_error_count = ErrorHandler::get_total_count(); \
+        auto expr_a_value = EXPR_A; \
+        auto expr_b_value = EXPR_B; \
+        std::int64_t error_count = ErrorHandler::get_total_count() - previous_error_count; \
+        ErrorHandler::set_suppress_all(suppress_all); \
+        godot::Testing::ArrayComparison comparison = godot::Testing::compare_packed_arrays(expr_a_value, expr_b_value, TOLERANCE); \
+        int check_result = error_count > 0 ? CHECK_ERRORED : comparison.is_match() ? CHECK_PASSED : CHECK_FAILED; \
+        return report_check(check_string, __FILE__, __LINE__, check_start_nsec, check_result, [&]() \
+        { \
+            print_output(vformat("        EXPR_A code: %s", #EXPR_A)); \
+            print_output(vformat("        EXPR_B code: %s", #EXPR_B)); \
+            PackedStringArray comparison_lines = godot::Testing::describe_array_comparison(comparison, expr_a_value, expr_b_value); \
+            for (std::int64_t i = 0; i < comparison_lines.size(); ++i) \
+                print_output("        " + comparison_lines[i]); \
+            if (check_result == CHECK_ERRORED) \
+                _PRINT_ERRORED_DETAILS(error_count, get_last_n_errors); \
+        }); \
+    }()
+
+#define CHECK_ARRAYS_EQUAL(EXPR_A, EXPR_B) _CHECK_ARRAYS(EXPR_A, EXPR_B, godot::Testing::ArrayTolerance(), "CHECK_ARRAYS_EQUAL(EXPR_A, EXPR_B)")
+
+// TOLERANCE is a godot::Testing::ArrayTolerance, such as ArrayTolerance::ulps(4).with_absolute(1e-6)
+#define CHECK_ARRAYS_APPROX_EQUAL(EXPR_A, EXPR_B, TOLERANCE) _CHECK_ARRAYS(EXPR_A, EXPR_B, TOLERANCE, "CHECK_ARRAYS_APPROX_EQUAL(EXPR_A, EXPR_B, TOLERANCE)")
+
+// Macros for benchmarking an expression (only available in benchmark cases)
+
+#define BENCHMARK(NAME, EXPR) run_benchmark(NAME, __FILE__, __LINE__, [&]() -> decltype(auto) { return EXPR; })
+
+// Benchmarks an expression like BENCHMARK, and fails if it is significantly slower than the
+// baseline stored under NAME (only available in benchmark cases)
+#define CHECK_NO_REGRESSION(NAME, EXPR) check_no_regression(NAME, __FILE__, __LINE__, [&]() -> decltype(auto) { return EXPR; })
+
+// Macros for running code from several threads at once (only available in stress test cases)
+
+// BODY is a callable taking no arguments, or the index of the thread and of the iteration (as
+// std::int64_t), which is run on each thread count of the test case
+#define STRESS(NAME, ...) run_stress(NAME, __FILE__, __LINE__, __VA_ARGS__)
+
 #endif
@@ -0,0 +1,148 @@
+#include "testing/test_report.h"
+
+#include "testing/test_macros.h"
+
+namespace godot::Testing
+{
+    static String result_to_string(int result)
+    {
+        if (result == CHECK_PASSED)
+            return "passed";
+        else if (result == CHECK_FAILED)
+            return "failed";
+        else
+            return "errored";
+    }
+
+    static Dictionary record_to_dictionary(const CheckRecord& record)
+    {
+        Dictionary dictionary;
+        dictionary["check"] = String(record.check_string);
+        dictionary["file"] = String(record.file);
+        dictionary["line"] = record.line;
+        dictionary["result"] = result_to_string(record.result);
+        dictionary["count"] = record.count;
+        dictionary["duration_nsec"] = record.duration_nsec;
+        dictionary["details"] = record.details;
+        return dictionary;
+    }
+
+    void TestReport::add_check(const char* check_string, const char* file, std::int32_t line, int result, std::int64_t count, std::int64_t duration_nsec, const String& details)
+    {
+        m_check_records.push_back({check_string, file, line, std::int8_t(result), count, duration_nsec, details});
+    }
+
+    const std::vector<CheckRecord>& TestReport::get_check_records() const
+    {
+        return m_check_records;
+    }
+
+    String TestReport::get_test_case_name() const
+    {
+        return m_test_case_name;
+    }
+
+    void TestReport::set_test_case_name(const String& test_case_name)
+    {
+        m_test_case_name = test_case_name;
+    }
+
+    std::int64_t TestReport::get_passed_checks() const
+    {
+        return m_passed_checks;
+    }
+
+    std::int64_t TestReport::get_failed_checks() const
+    {
+        return m_failed_checks;
+    }
+
+    std::int64_t TestReport::get_errored_checks() const
+    {
+        return m_errored_checks;
+    }
+
+    void TestReport::set_check_counts(std::int64_t passed_checks, std::int64_t failed_checks, std::int64_t errored_checks)
+    {
+        m_passed_checks = passed_checks;
+        m_failed_checks = failed_checks;
+        m_errored_checks = errored_checks;
+    }
+
+    String TestReport::get_result() const
+    {
+        if (m_errored_checks > 0)
+            return "errored";
+        else if (m_failed_checks == 0)
+            return "passed";
+        else if (m_passed_checks == 0)
+            return "failed";
+        else
+            return "mixed";
+    }
+
+    std::int64_t TestReport::get_duration_usec() const
+    {
+        return m_duration_usec;
+    }
+
+    void TestReport::set_duration_usec(std::int64_t duration_usec)
+    {
+        m_duration_usec = duration_usec;
+    }
+
+    std::int64_t TestReport::get_check_count() const
+    {
+        return m_check_records.size();
+    }
+
+    Dictionary TestReport::get_check(std::int64_t index) const
+    {
+        ERR_FAIL_INDEX_V(index, std::int64_t(m_check_records.size()), Dictionary());
+        return record_to_dictionary(m_check_records[index]);
+    }
+
+    Array TestReport::get_checks() const
+    {
+        Array checks;
+        for (const CheckRecord& record : m_check_records)
+            checks.push_back(record_to_dictionary(record));
+        return checks;
+    }
+
+    Array TestReport::get_unpassed_checks() const
+    {
+        Array checks;
+        for (const CheckRecord& record : m_check_records)
+            if (record.result != CHECK_PASSED)
+                checks.push_back(record_to_dictionary(record));
+        return checks;
+    }
+
+    void TestReport::_bind_methods()
+    {
+        ClassDB::bind_method(D_METHOD("get_test_case_name"), &TestReport::get_test_case_name);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "test_case_name", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_test_case_name");
+
+        ClassDB::bind_method(D_METHOD("get_passed_checks"), &TestReport::get_passed_checks);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "passed_checks", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_passed_checks");
+
+        ClassDB::bind_method(D_METHOD("get_failed_checks"), &TestReport::get_failed_checks);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "failed_checks", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_failed_checks");
+
+        ClassDB::bind_method(D_METHOD("get_errored_checks"), &TestReport::get_errored_checks);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "errored_checks", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_errored_checks");
+
+        ClassDB::bind_method(D_METHOD("get_result"), &TestReport::get_result);
+
+        ClassDB::bind_method(D_METHOD("get_duration_usec"), &TestReport::get_duration_usec);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "duration_usec", PROPERTY_HINT_NONE, "suffix:us", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_duration_usec");
+
+        ClassDB::bind_method(D_METHOD("get_check_count"), &TestReport::get_check_count);
+        ClassDB::bind_method(D_METHOD("get_check", "index"), &TestReport::get_check);
+        ClassDB::bind_method(D_METHOD("get_unpassed_checks"), &TestReport::get_unpassed_checks);
+
+        ClassDB::bind_method(D_METHOD("get_checks"), &TestReport::get_checks);
+        ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "checks", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_checks");
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef TEST_REPORT_H
+#define TEST_REPORT_H
+
+#include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <vector>
+
+namespace godot::Testing
+{
+    // The outcome of a single check. The check string and file name point at string literals, so
+    // a record only allocates when it carries details.
+    struct CheckRecord
+    {
+        const char* check_string = "";
+        const char* file = "";
+        std::int32_t line = 0;
+        std::int8_t result = 0;
+        std::int64_t count = 1;
+        // Zero unless checks are timed
+        std::int64_t duration_nsec = 0;
+        String details;
+    };
+
+    // The structured results of one run of a test case
+    class TestReport : public Resource
+    {
+        GDCLASS(TestReport, Resource)
+
+    public:
+        void add_check(const char* check_string, const char* file, std::int32_t line, int result, std::int64_t count, std::int64_t duration_nsec, const String& details);
+        const std::vector<CheckRecord>& get_check_records() const;
+
+        String get_test_case_name() const;
+        void set_test_case_name(const String& test_case_name);
+
+        std::int64_t get_passed_checks() const;
+        std::int64_t get_failed_checks() const;
+        std::int64_t get_errored_checks() const;
+        void set_check_counts(std::int64_t passed_checks, std::int64_t failed_checks, std::int64_t errored_checks);
+
+        // "passed", "mixed", or "failed" (like the results printed for the test case), or "errored"
+        // if any check had unexpected errors
+        String get_result() const;
+
+        std::int64_t get_duration_usec() const;
+        void set_duration_usec(std::int64_t duration_usec);
+
+        std::int64_t get_check_count() const;
+        Dictionary get_check(std::int64_t index) const;
+        Array get_checks() const;
+        Array get_unpassed_checks() const;
+
+    protected:
+        static void _bind_methods();
+
+        std::vector<CheckRecord> m_check_records;
+
+        String m_test_case_name;
+
+        std::int64_t m_passed_checks = 0;
+        std::int64_t m_failed_checks = 0;
+        std::int64_t m_errored_checks = 0;
+
+        std::int64_t m_duration_usec = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include "testing/test_result_cache.h"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/json.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace godot::Testing
+{
+    String TestResultCache::make_key(const String& test_suite_class, const String& test_case_class)
+    {
+        return test_suite_class + "/" + test_case_class;
+    }
+
+    bool TestResultCache::load(const String& path)
+    {
+        m_path = path;
+        m_entries.clear();
+        if (!FileAccess::file_exists(path))
+            return false;
+
+        Variant entries = JSON::parse_string(FileAccess::get_file_as_string(path));
+        if (entries.get_type() != Variant::DICTIONARY)
+            return false;
+
+        m_entries = entries;
+        return true;
+    }
+
+    Error TestResultCache::save() const
+    {
+        Ref<FileAccess> file = FileAccess::open(m_path, FileAccess::WRITE);
+        if (file.is_null())
+            return FileAccess::get_open_error();
+
+        file->store_string(JSON::stringify(m_entries, "\t"));
+        return OK;
+    }
+
+    bool TestResultCache::has_entry(const String& key) const
+    {
+        return m_entries.has(key);
+    }
+
+    String TestResultCache::get_result(const String& key) const
+    {
+        if (!m_entries.has(key))
+            return String();
+        return Dictionary(m_entries[key]).get("result", String());
+    }
+
+    std::int64_t TestResultCache::get_duration_usec(const String& key, std::int64_t default_duration_usec) const
+    {
+        if (!m_entries.has(key))
+            return default_duration_usec;
+        return Dictionary(m_entries[key]).get("duration_usec", default_duration_usec);
+    }
+
+    void TestResultCache::record(const String& key, const String& result, std::int64_t duration_usec)
+    {
+        Dictionary entry;
+        entry["result"] = result;
+        entry["duration_usec"] = duration_usec;
+        m_entries[key] = entry;
+    }
+
+    std::int64_t TestResultCache::get_typical_duration_usec() const
+    {
+        std::vector<std::int64_t> durations;
+        Array entries = m_entries.values();
+        for (std::int64_t i = 0; i < entries.size(); ++i)
+            durations.push_back(std::int64_t(Dictionary(entries[i]).get("duration_usec", 0)));
+        if (durations.empty())
+            return 0;
+
+        std::nth_element(durations.begin(), durations.begin() + durations.size() / 2, durations.end());
+        return durations[durations.size() / 2];
+    }
+
+    String TestResultCache::get_path() const
+    {
+        return m_path;
+    }
+
+    void TestResultCache::set_path(const String& path)
+    {
+        m_path = path;
+    }
+
+    void TestResultCache::_bind_methods()
+    {
+        ClassDB::bind_static_method("TestResultCache", D_METHOD("make_key", "test_suite_class", "test_case_class"), &TestResultCache::make_key);
+
+        ClassDB::bind_method(D_METHOD("load", "path"), &TestResultCache::load);
+        ClassDB::bind_method(D_METHOD("save"), &TestResultCache::save);
+        ClassDB::bind_method(D_METHOD("has_entry", "key"), &TestResultCache::has_entry);
+        ClassDB::bind_method(D_METHOD("get_result", "key"), &TestResultCache::get_result);
+        ClassDB::bind_method(D_METHOD("get_duration_usec", "key", "default_duration_usec"), &TestResultCache::get_duration_usec, DEFVAL(-1));
+        ClassDB::bind_method(D_METHOD("record", "key", "result", "duration_usec"), &TestResultCache::record);
+        ClassDB::bind_method(D_METHOD("get_typical_duration_usec"), &TestResultCache::get_typical_duration_usec);
+
+        ClassDB::bind_method(D_METHOD("get_path"), &TestResultCache::get_path);
+        ClassDB::bind_method(D_METHOD("set_path", "path"), &TestResultCache::set_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "path", PROPERTY_HINT_SAVE_FILE, "*.json"), "set_path", "get_path");
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef TEST_RESULT_CACHE_H
+#define TEST_RESULT_CACHE_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+namespace godot::Testing
+{
+    // Remembers the last result and duration of each test case across runs, keyed by
+    // "TestSuiteClass/TestCaseClass". The cache is stored as JSON.
+    class TestResultCache : public RefCounted
+    {
+        GDCLASS(TestResultCache, RefCounted)
+
+    public:
+        static constexpr const char* DEFAULT_PATH = "user://test_results.json";
+
+        static String make_key(const String& test_suite_class, const String& test_case_class);
+
+        // Returns false (and leaves the cache empty) if the file does not exist or cannot be parsed
+        bool load(const String& path);
+        Error save() const;
+
+        bool has_entry(const String& key) const;
+        // "passed", "mixed", "failed", or "errored", or an empty string if there is no entry
+        String get_result(const String& key) const;
+        std::int64_t get_duration_usec(const String& key, std::int64_t default_duration_usec = -1) const;
+        void record(const String& key, const String& result, std::int64_t duration_usec);
+
+        // The median duration of all entries, for estimating test cases that have not run yet
+        std::int64_t get_typical_duration_usec() const;
+
+        String get_path() const;
+        void set_path(const String& path);
+
+    protected:
+        static void _bind_methods();
+
+        String m_path = DEFAULT_PATH;
+        Dictionary m_entries;
+    };
+}
+
+#endif
@@ -0,0 +1,742 @@
+#include "testing/test_runner.h"
+
+#include <godot_cpp/classes/class_db_singleton.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/display_server.hpp>
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/json.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/packed_scene.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+namespace godot::Testing
+{
+    static PackedStringArray split_list(const String& list)
+    {
+        return list.split(",", false);
+    }
+
+    void TestRunner::_ready()
+    {
+        set_process(false);
+        if (Engine::get_singleton()->is_editor_hint())
+            return;
+
+        // Wait until the rest of the scene tree is ready
+        callable_mp(this, &TestRunner::run_and_quit).call_deferred();
+    }
+
+    void TestRunner::_process(double delta)
+    {
+        if (m_shard_coordinator.is_null())
+        {
+            set_process(false);
+            return;
+        }
+
+        if (m_shard_coordinator->poll())
+            finish_sharded_run();
+    }
+
+    void TestRunner::_notification(int p_what)
+    {
+        // Quitting (or closing the window) in the middle of a sharded run must not leave the
+        // workers running on their own
+        if ((p_what == NOTIFICATION_WM_CLOSE_REQUEST || p_what == NOTIFICATION_PREDELETE) && m_shard_coordinator.is_valid())
+            m_shard_coordinator->kill_workers();
+    }
+
+    void TestRunner::run_and_quit()
+    {
+        // Without a window, nothing but the test cases creates objects while they run
+        TestCase::set_leak_checks_enabled(DisplayServer::get_singleton()->get_name() == "headless");
+
+        if (!parse_command_line())
+        {
+            m_exit_code = EXIT_NO_TEST_SUITES;
+            if (m_quit_when_done)
+                get_tree()->quit(m_exit_code);
+            return;
+        }
+
+        run();
+    }
+
+    bool TestRunner::parse_command_line()
+    {
+        PackedStringArray arguments = OS::get_singleton()->get_cmdline_user_args();
+        for (std::int64_t i = 0; i < arguments.size(); ++i)
+        {
+            const String& argument = arguments[i];
+            if (argument.begins_with("--suite="))
+                m_suite_filter.append_array(split_list(argument.trim_prefix("--suite=")));
+            else if (argument.begins_with("--case="))
+                m_test_case_filter.append_array(split_list(argument.trim_prefix("--case=")));
+            else if (argument.begins_with("--scenes="))
+            {
+                m_test_scenes.append_array(split_list(argument.trim_prefix("--scenes=")));
+                m_worker_arguments.push_back(argument);
+            }
+            else if (argument.begins_with("--junit="))
+            {
+                m_junit_path = argument.trim_prefix("--junit=");
+                m_worker_arguments.push_back(argument);
+            }
+            else if (argument.begins_with("--json="))
+                m_json_path = argument.trim_prefix("--json=");
+            else if (argument == "--parallel" || argument == "--time-checks" || argument == "--details")
+            {
+                m_parallel = m_parallel || argument == "--parallel";
+                m_time_checks = m_time_checks || argument == "--time-checks";
+                m_suppress_details = m_suppress_details && argument != "--details";
+                m_worker_arguments.push_back(argument);
+            }
+            else if (argument == "--list")
+                m_list_only = true;
+            else if (argument == "--failed-first")
+                m_failed_first = true;
+            else if (argument == "--update-baselines")
+            {
+                BenchmarkCase::set_update_all_baselines(true);
+                m_update_baselines = true;
+            }
+            else if (argument == "--update-snapshots")
+            {
+                TestCase::set_update_all_snapshots(true);
+                m_worker_arguments.push_back(argument);
+            }
+            else if (argument.begins_with("--property-seed="))
+            {
+                TestCase::set_property_seed_override(argument.trim_prefix("--property-seed=").to_int());
+                m_worker_arguments.push_back(argument);
+            }
+            else if (argument == "--record-impact")
+                m_record_impact = true;
+            else if (argument == "--affected-only")
+                m_affected_only = true;
+            else if (argument.begins_with("--impact-map="))
+                m_impact_map_path = argument.trim_prefix("--impact-map=");
+            else if (argument == "--fail-fast")
+            {
+                m_fail_fast = true;
+                m_worker_arguments.push_back(argument);
+            }
+            else if (argument.begins_with("--shards=") && argument.trim_prefix("--shards=").is_valid_int())
+                m_shard_count = argument.trim_prefix("--shards=").to_int();
+            else if (argument.begins_with("--results-cache="))
+                m_results_cache_path = argument.trim_prefix("--results-cache=");
+            else if (argument.begins_with("--shard-plan="))
+                m_shard_plan_path = argument.trim_prefix("--shard-plan=");
+            else if (argument.begins_with("--shard-index=") && argument.trim_prefix("--shard-index=").is_valid_int())
+                m_shard_index = argument.trim_prefix("--shard-index=").to_int();
+            else
+            {
+                UtilityFunctions::printerr(vformat("Unknown test runner argument: %s", argument));
+                UtilityFunctions::printerr("Usage: -- [--suite=PATTERNS] [--case=PATTERNS] [--scenes=PATHS] [--junit=PATH] [--json=PATH] [--parallel] [--time-checks] [--details] [--list] [--failed-first] [--fail-fast] [--update-baselines] [--update-snapshots] [--property-seed=N] [--record-impact] [--affected-only] [--impact-map=PATH] [--shards=N] [--results-cache=PATH]");
+                return false;
+            }
+        }
+
+        // The workers would all rewrite the same baseline file and impact map at once, and
+        // --affected-only would have to filter the test cases before they are planned
+        if (m_shard_count > 1 && (m_update_baselines || m_record_impact || m_affected_only))
+        {
+            UtilityFunctions::printerr("--update-baselines, --record-impact, and --affected-only cannot be combined with --shards");
+            return false;
+        }
+
+        if (m_shard_index >= 0)
+        {
+            if (!load_shard_plan())
+                return false;
+
+            // Each worker writes its own JUnit file next to the requested one
+            if (!m_junit_path.is_empty())
+                m_junit_path = vformat("%s.shard%d.%s", m_junit_path.get_basename(), m_shard_index, m_junit_path.get_extension());
+        }
+        return true;
+    }
+
+    bool TestRunner::load_shard_plan()
+    {
+        Variant plan = JSON::parse_string(FileAccess::get_file_as_string(m_shard_plan_path));
+        if (plan.get_type() != Variant::ARRAY || m_shard_index >= Array(plan).size())
+        {
+            UtilityFunctions::printerr(vformat("Could not read shard %d of the shard plan: %s", m_shard_index, m_shard_plan_path));
+            return false;
+        }
+
+        m_shard_test_cases = Array(plan)[m_shard_index];
+        m_suite_filter = PackedStringArray(m_shard_test_cases.keys());
+        return true;
+    }
+
+    void TestRunner::run()
+    {
+        ERR_FAIL_COND_MSG(m_running, "The test runner is already running.");
+
+        m_output_sink.instantiate();
+        if (m_shard_count > 1 && m_shard_index < 0 && !m_list_only)
+        {
+            run_sharded();
+            return;
+        }
+
+        m_test_suites = load_test_suites();
+        if (m_test_suites.empty())
+        {
+            UtilityFunctions::printerr("No test suites matched.");
+            m_exit_code = EXIT_NO_TEST_SUITES;
+            finish();
+            return;
+        }
+
+        if (m_list_only)
+        {
+            for (TestSuite* test_suite : m_test_suites)
+            {
+                m_output_sink->print_line(vformat("%s%s%s", TEST_NAME_START, test_suite->get_class(), TEST_NAME_END));
+                PackedStringArray test_case_names = test_suite->get_test_case_names();
+                for (std::int64_t i = 0; i < test_case_names.size(); ++i)
+                    m_output_sink->print_line(vformat("    %s", test_case_names[i]));
+            }
+            m_exit_code = EXIT_PASSED;
+            finish();
+            return;
+        }
+
+        m_report_writers.clear();
+        if (!m_junit_path.is_empty())
+        {
+            Ref<JUnitReportWriter> junit_report_writer;
+            junit_report_writer.instantiate();
+            junit_report_writer->set_path(m_junit_path);
+            m_report_writers.push_back(junit_report_writer);
+        }
+        if (!m_json_path.is_empty())
+        {
+            Ref<JsonReportWriter> json_report_writer;
+            json_report_writer.instantiate();
+            json_report_writer->set_path(m_json_path);
+            m_report_writers.push_back(json_report_writer);
+        }
+
+        m_running = true;
+        m_exit_code = EXIT_PASSED;
+        m_failed_test_suites = 0;
+        m_next_test_suite_index = 0;
+        m_stopped_early = false;
+        run_next_test_suites();
+    }
+
+    bool TestRunner::is_running() const
+    {
+        return m_running;
+    }
+
+    void TestRunner::run_next_test_suites()
+    {
+        while (m_next_test_suite_index < m_test_suites.size() && !m_stopped_early)
+        {
+            TestSuite* test_suite = m_test_suites[m_next_test_suite_index];
+            if (m_failed_first)
+            {
+                test_suite->set_use_result_cache(true);
+                test_suite->set_result_cache_path(m_results_cache_path);
+            }
+            if (m_fail_fast)
+                test_suite->set_fail_fast(true);
+            if (m_record_impact || m_affected_only)
+            {
+                test_suite->set_record_impact(m_record_impact);
+                test_suite->set_affected_only(m_affected_only);
+                test_suite->set_impact_map_path(m_impact_map_path);
+            }
+            if (m_parallel)
+                test_suite->set_parallel(true);
+            test_suite->set_suppress_details(m_suppress_details);
+            if (m_time_checks)
+                test_suite->set_time_checks(true);
+            if (m_shard_index >= 0)
+                test_suite->set_test_case_filter(m_shard_test_cases.get(test_suite->get_class(), PackedStringArray()));
+            else
+                test_suite->set_test_case_filter(m_test_case_filter);
+            m_previous_report_writers = test_suite->get_report_writers();
+            TypedArray<ReportWriter> test_suite_report_writers = m_previous_report_writers.duplicate();
+            test_suite_report_writers.append_array(m_report_writers);
+            test_suite->set_report_writers(test_suite_report_writers);
+            test_suite->run_all_test_cases();
+
+            // Test suites with asynchronous test cases finish on a later frame
+            if (test_suite->is_running())
+            {
+                test_suite->connect("run_finished", callable_mp(this, &TestRunner::on_test_suite_finished));
+                test_suite->connect("run_cancelled", callable_mp(this, &TestRunner::on_test_suite_finished));
+                return;
+            }
+            on_test_suite_done(test_suite);
+        }
+
+        finish();
+    }
+
+    void TestRunner::on_test_suite_finished()
+    {
+        TestSuite* test_suite = m_test_suites[m_next_test_suite_index];
+        test_suite->disconnect("run_finished", callable_mp(this, &TestRunner::on_test_suite_finished));
+        test_suite->disconnect("run_cancelled", callable_mp(this, &TestRunner::on_test_suite_finished));
+        on_test_suite_done(test_suite);
+        run_next_test_suites();
+    }
+
+    void TestRunner::on_test_suite_done(TestSuite* test_suite)
+    {
+        test_suite->set_report_writers(m_previous_report_writers);
+        if (test_suite->get_failed_test_cases() + test_suite->get_mixed_test_cases() + test_suite->get_errored_test_cases() > 0)
+        {
+            m_failed_test_suites++;
+            m_exit_code = EXIT_FAILED;
+            m_stopped_early = m_fail_fast;
+        }
+        m_next_test_suite_index++;
+    }
+
+    void TestRunner::finish()
+    {
+        if (m_running)
+        {
+            m_output_sink->print_line(vformat("%s test suites run, %s with failures or errors", std::int64_t(m_next_test_suite_index), m_failed_test_suites));
+            if (m_stopped_early)
+                m_output_sink->print_line(vformat("Stopped after the first failure, %s test suites not run", std::int64_t(m_test_suites.size() - m_next_test_suite_index)));
+        }
+        m_output_sink->flush();
+        m_running = false;
+
+        for (std::int64_t i = 0; i < m_report_writers.size(); ++i)
+            Ref<ReportWriter>(m_report_writers[i])->close();
+        m_report_writers.clear();
+
+        // Tells the coordinator that the rest of this shard was skipped rather than lost
+        if (m_shard_index >= 0 && m_stopped_early && !m_json_path.is_empty())
+        {
+            Ref<FileAccess> file = FileAccess::open(m_json_path, FileAccess::READ_WRITE);
+            if (file.is_valid())
+            {
+                file->seek_end();
+                Dictionary line;
+                line["type"] = "stopped_early";
+                file->store_line(JSON::stringify(line));
+            }
+        }
+
+        for (Node* loaded_node : m_loaded_nodes)
+            loaded_node->queue_free();
+        m_loaded_nodes.clear();
+        m_test_suites.clear();
+
+        emit_signal("finished", m_exit_code);
+        if (m_quit_when_done)
+            get_tree()->quit(m_exit_code);
+    }
+
+    void TestRunner::run_sharded()
+    {
+        Ref<TestResultCache> result_cache;
+        result_cache.instantiate();
+        result_cache->load(m_results_cache_path);
+
+        m_shard_coordinator.instantiate();
+        m_shard_coordinator->set_shard_count(m_shard_count);
+        m_shard_coordinator->set_result_cache(result_cache);
+
+        // The test suites are only loaded here to find their test cases, which the workers run
+        m_test_suites = load_test_suites();
+        for (TestSuite* test_suite : m_test_suites)
+        {
+            test_suite->set_test_case_filter(m_test_case_filter);
+            TypedArray<TestCase> test_cases = test_suite->get_selected_test_cases();
+            for (std::int64_t i = 0; i < test_cases.size(); ++i)
+                m_shard_coordinator->add_test_case(test_suite->get_class(), Ref<TestCase>(test_cases[i])->get_class());
+        }
+        for (Node* loaded_node : m_loaded_nodes)
+            loaded_node->queue_free();
+        m_loaded_nodes.clear();
+        m_test_suites.clear();
+
+        if (m_shard_coordinator->get_test_case_count() == 0)
+        {
+            UtilityFunctions::printerr("No test cases matched.");
+            m_shard_coordinator.unref();
+            m_exit_code = EXIT_NO_TEST_SUITES;
+            finish();
+            return;
+        }
+
+        Error error = m_shard_coordinator->start(get_tree()->get_current_scene()->get_scene_file_path(), m_worker_arguments);
+        if (error != OK)
+        {
+            UtilityFunctions::printerr(vformat("Could not start the shard workers: %s", UtilityFunctions::error_string(error)));
+            m_shard_coordinator.unref();
+            m_exit_code = EXIT_FAILED;
+            finish();
+            return;
+        }
+
+        m_running = true;
+        set_process(true);
+    }
+
+    void TestRunner::finish_sharded_run()
+    {
+        set_process(false);
+        m_exit_code = m_shard_coordinator->merge_results(m_output_sink) > 0 ? EXIT_FAILED : EXIT_PASSED;
+        if (!m_json_path.is_empty())
+        {
+            Error error = m_shard_coordinator->write_merged_json(m_json_path);
+            if (error != OK)
+                UtilityFunctions::printerr(vformat("Could not write the merged results to %s: %s", m_json_path, UtilityFunctions::error_string(error)));
+        }
+        if (!m_junit_path.is_empty())
+        {
+            // Next to the JUnit files of the workers, for the test cases they never reported
+            Ref<JUnitReportWriter> junit_report_writer;
+            junit_report_writer.instantiate();
+            junit_report_writer->set_path(vformat("%s.unreported.%s", m_junit_path.get_basename(), m_junit_path.get_extension()));
+            m_shard_coordinator->write_unreported_test_cases(junit_report_writer);
+        }
+        m_shard_coordinator.unref();
+
+        // The workers already printed their own summaries
+        m_running = false;
+        finish();
+    }
+
+    std::vector<TestSuite*> TestRunner::load_test_suites()
+    {
+        std::vector<TestSuite*> test_suites;
+
+        if (m_test_scenes.is_empty())
+        {
+            // Instantiate every registered test suite class
+            ClassDBSingleton* class_db = ClassDBSingleton::get_singleton();
+            PackedStringArray test_suite_classes = class_db->get_inheriters_from_class("TestSuite");
+            test_suite_classes.sort();
+            for (std::int64_t i = 0; i < test_suite_classes.size(); ++i)
+            {
+                if (!class_db->can_instantiate(test_suite_classes[i]) || !matches_suite_filter(test_suite_classes[i]))
+                    continue;
+
+                TestSuite* test_suite = Object::cast_to<TestSuite>(class_db->instantiate(test_suite_classes[i]));
+                if (test_suite == nullptr)
+                    continue;
+                test_suite->instantiate_missing_test_cases();
+                add_child(test_suite);
+                m_loaded_nodes.push_back(test_suite);
+                test_suites.push_back(test_suite);
+            }
+            return test_suites;
+        }
+
+        PackedStringArray scene_paths;
+        for (std::int64_t i = 0; i < m_test_scenes.size(); ++i)
+            find_scene_paths(m_test_scenes[i], scene_paths);
+
+        for (std::int64_t i = 0; i < scene_paths.size(); ++i)
+        {
+            Ref<PackedScene> scene = ResourceLoader::get_singleton()->load(scene_paths[i], "PackedScene");
+            if (scene.is_null())
+            {
+                UtilityFunctions::printerr(vformat("Could not load test scene: %s", scene_paths[i]));
+                continue;
+            }
+
+            Node* scene_root = scene->instantiate();
+            TypedArray<Node> nodes = scene_root->find_children("*", "TestSuite", true, false);
+            nodes.push_front(scene_root);
+
+            bool has_test_suites = false;
+            for (std::int64_t j = 0; j < nodes.size(); ++j)
+            {
+                TestSuite* test_suite = Object::cast_to<TestSuite>(nodes[j]);
+                if (test_suite == nullptr || !matches_suite_filter(test_suite->get_class()))
+                    continue;
+                test_suites.push_back(test_suite);
+                has_test_suites = true;
+            }
+
+            if (has_test_suites)
+            {
+                add_child(scene_root);
+                m_loaded_nodes.push_back(scene_root);
+            }
+            else
+            {
+                scene_root->queue_free();
+            }
+        }
+        return test_suites;
+    }
+
+    void TestRunner::find_scene_paths(const String& path, PackedStringArray& r_scene_paths) const
+    {
+        if (!DirAccess::dir_exists_absolute(path))
+        {
+            r_scene_paths.push_back(path);
+            return;
+        }
+
+        PackedStringArray files = DirAccess::get_files_at(path);
+        for (std::int64_t i = 0; i < files.size(); ++i)
+        {
+            if (files[i].ends_with(".tscn") || files[i].ends_with(".scn"))
+                r_scene_paths.push_back(path.path_join(files[i]));
+        }
+
+        PackedStringArray directories = DirAccess::get_directories_at(path);
+        for (std::int64_t i = 0; i < directories.size(); ++i)
+            find_scene_paths(path.path_join(directories[i]), r_scene_paths);
+    }
+
+    bool TestRunner::matches_suite_filter(const String& test_suite_class) const
+    {
+        if (m_suite_filter.is_empty())
+            return true;
+
+        for (std::int64_t i = 0; i < m_suite_filter.size(); ++i)
+        {
+            if (test_suite_class.match(m_suite_filter[i]))
+                return true;
+        }
+        return false;
+    }
+
+    PackedStringArray TestRunner::get_suite_filter() const
+    {
+        return m_suite_filter;
+    }
+
+    void TestRunner::set_suite_filter(const PackedStringArray& suite_filter)
+    {
+        m_suite_filter = suite_filter;
+    }
+
+    PackedStringArray TestRunner::get_test_case_filter() const
+    {
+        return m_test_case_filter;
+    }
+
+    void TestRunner::set_test_case_filter(const PackedStringArray& test_case_filter)
+    {
+        m_test_case_filter = test_case_filter;
+    }
+
+    PackedStringArray TestRunner::get_test_scenes() const
+    {
+        return m_test_scenes;
+    }
+
+    void TestRunner::set_test_scenes(const PackedStringArray& test_scenes)
+    {
+        m_test_scenes = test_scenes;
+    }
+
+    bool TestRunner::get_parallel() const
+    {
+        return m_parallel;
+    }
+
+    void TestRunner::set_parallel(bool parallel)
+    {
+        m_parallel = parallel;
+    }
+
+    bool TestRunner::get_suppress_details() const
+    {
+        return m_suppress_details;
+    }
+
+    void TestRunner::set_suppress_details(bool suppress_details)
+    {
+        m_suppress_details = suppress_details;
+    }
+
+    String TestRunner::get_junit_path() const
+    {
+        return m_junit_path;
+    }
+
+    void TestRunner::set_junit_path(const String& junit_path)
+    {
+        m_junit_path = junit_path;
+    }
+
+    String TestRunner::get_json_path() const
+    {
+        return m_json_path;
+    }
+
+    void TestRunner::set_json_path(const String& json_path)
+    {
+        m_json_path = json_path;
+    }
+
+    std::int64_t TestRunner::get_shard_count() const
+    {
+        return m_shard_count;
+    }
+
+    void TestRunner::set_shard_count(std::int64_t shard_count)
+    {
+        m_shard_count = shard_count;
+    }
+
+    String TestRunner::get_results_cache_path() const
+    {
+        return m_results_cache_path;
+    }
+
+    void TestRunner::set_results_cache_path(const String& results_cache_path)
+    {
+        m_results_cache_path = results_cache_path;
+    }
+
+    bool TestRunner::get_failed_first() const
+    {
+        return m_failed_first;
+    }
+
+    void TestRunner::set_failed_first(bool failed_first)
+    {
+        m_failed_first = failed_first;
+    }
+
+    bool TestRunner::get_fail_fast() const
+    {
+        return m_fail_fast;
+    }
+
+    void TestRunner::set_fail_fast(bool fail_fast)
+    {
+        m_fail_fast = fail_fast;
+    }
+
+    bool TestRunner::get_record_impact() const
+    {
+        return m_record_impact;
+    }
+
+    void TestRunner::set_record_impact(bool record_impact)
+    {
+        m_record_impact = record_impact;
+    }
+
+    bool TestRunner::get_affected_only() const
+    {
+        return m_affected_only;
+    }
+
+    void TestRunner::set_affected_only(bool affected_only)
+    {
+        m_affected_only = affected_only;
+    }
+
+    String TestRunner::get_impact_map_path() const
+    {
+        return m_impact_map_path;
+    }
+
+    void TestRunner::set_impact_map_path(const String& impact_map_path)
+    {
+        m_impact_map_path = impact_map_path;
+    }
+
+    bool TestRunner::get_quit_when_done() const
+    {
+        return m_quit_when_done;
+    }
+
+    void TestRunner::set_quit_when_done(bool quit_when_done)
+    {
+        m_quit_when_done = quit_when_done;
+    }
+
+    int TestRunner::get_exit_code() const
+    {
+        return m_exit_code;
+    }
+
+    void TestRunner::_bind_methods()
+    {
+        ClassDB::bind_method(D_METHOD("run"), &TestRunner::run);
+        ClassDB::bind_method(D_METHOD("is_running"), &TestRunner::is_running);
+
+        ClassDB::bind_method(D_METHOD("get_suite_filter"), &TestRunner::get_suite_filter);
+        ClassDB::bind_method(D_METHOD("set_suite_filter", "suite_filter"), &TestRunner::set_suite_filter);
+        ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "suite_filter"), "set_suite_filter", "get_suite_filter");
+
+        ClassDB::bind_method(D_METHOD("get_test_case_filter"), &TestRunner::get_test_case_filter);
+        ClassDB::bind_method(D_METHOD("set_test_case_filter", "test_case_filter"), &TestRunner::set_test_case_filter);
+        ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "test_case_filter"), "set_test_case_filter", "get_test_case_filter");
+
+        ClassDB::bind_method(D_METHOD("get_test_scenes"), &TestRunner::get_test_scenes);
+        ClassDB::bind_method(D_METHOD("set_test_scenes", "test_scenes"), &TestRunner::set_test_scenes);
+        ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "test_scenes", PROPERTY_HINT_TYPE_STRING, vformat("%d/%d:*.tscn,*.scn", Variant::STRING, PROPERTY_HINT_FILE)), "set_test_scenes", "get_test_scenes");
+
+        ClassDB::bind_method(D_METHOD("get_parallel"), &TestRunner::get_parallel);
+        ClassDB::bind_method(D_METHOD("set_parallel", "parallel"), &TestRunner::set_parallel);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "parallel"), "set_parallel", "get_parallel");
+
+        ClassDB::bind_method(D_METHOD("get_suppress_details"), &TestRunner::get_suppress_details);
+        ClassDB::bind_method(D_METHOD("set_suppress_details", "suppress_details"), &TestRunner::set_suppress_details);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "suppress_details"), "set_suppress_details", "get_suppress_details");
+
+        ClassDB::bind_method(D_METHOD("get_junit_path"), &TestRunner::get_junit_path);
+        ClassDB::bind_method(D_METHOD("set_junit_path", "junit_path"), &TestRunner::set_junit_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "junit_path", PROPERTY_HINT_SAVE_FILE, "*.xml"), "set_junit_path", "get_junit_path");
+
+        ClassDB::bind_method(D_METHOD("get_json_path"), &TestRunner::get_json_path);
+        ClassDB::bind_method(D_METHOD("set_json_path", "json_path"), &TestRunner::set_json_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "json_path", PROPERTY_HINT_SAVE_FILE, "*.jsonl"), "set_json_path", "get_json_path");
+
+        ClassDB::bind_method(D_METHOD("get_shard_count"), &TestRunner::get_shard_count);
+        ClassDB::bind_method(D_METHOD("set_shard_count", "shard_count"), &TestRunner::set_shard_count);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "shard_count", PROPERTY_HINT_RANGE, "0,256,1,or_greater"), "set_shard_count", "get_shard_count");
+
+        ClassDB::bind_method(D_METHOD("get_results_cache_path"), &TestRunner::get_results_cache_path);
+        ClassDB::bind_method(D_METHOD("set_results_cache_path", "results_cache_path"), &TestRunner::set_results_cache_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "results_cache_path", PROPERTY_HINT_SAVE_FILE, "*.json"), "set_results_cache_path", "get_results_cache_path");
+
+        ClassDB::bind_method(D_METHOD("get_failed_first"), &TestRunner::get_failed_first);
+        ClassDB::bind_method(D_METHOD("set_failed_first", "failed_first"), &TestRunner::set_failed_first);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "failed_first"), "set_failed_first", "get_failed_first");
+
+        ClassDB::bind_method(D_METHOD("get_fail_fast"), &TestRunner::get_fail_fast);
+        ClassDB::bind_method(D_METHOD("set_fail_fast", "fail_fast"), &TestRunner::set_fail_fast);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "fail_fast"), "set_fail_fast", "get_fail_fast");
+
+        ClassDB::bind_method(D_METHOD("get_record_impact"), &TestRunner::get_record_impact);
+        ClassDB::bind_method(D_METHOD("set_record_impact", "record_impact"), &TestRunner::set_record_impact);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "record_impact"), "set_record_impact", "get_record_impact");
+
+        ClassDB::bind_method(D_METHOD("get_affected_only"), &TestRunner::get_affected_only);
+        ClassDB::bind_method(D_METHOD("set_affected_only", "affected_only"), &TestRunner::set_affected_only);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "affected_only"), "set_affected_only", "get_affected_only");
+
+        ClassDB::bind_method(D_METHOD("get_impact_map_path"), &TestRunner::get_impact_map_path);
+        ClassDB::bind_method(D_METHOD("set_impact_map_path", "impact_map_path"), &TestRunner::set_impact_map_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "impact_map_path", PROPERTY_HINT_SAVE_FILE, "*.json"), "set_impact_map_path", "get_impact_map_path");
+
+        ClassDB::bind_method(D_METHOD("get_quit_when_done"), &TestRunner::get_quit_when_done);
+        ClassDB::bind_method(D_METHOD("set_quit_when_done", "quit_when_done"), &TestRunner::set_quit_when_done);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "quit_when_done"), "set_quit_when_done", "get_quit_when_done");
+
+        ClassDB::bind_method(D_METHOD("get_exit_code"), &TestRunner::get_exit_code);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "exit_code", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_exit_code");
+
+        ADD_SIGNAL(MethodInfo("finished", PropertyInfo(Variant::INT, "exit_code")));
+    }
+}
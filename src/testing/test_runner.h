@@ -0,0 +1,166 @@
+#ifndef TEST_RUNNER_H
+#define TEST_RUNNER_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+
+#include <vector>
+
+#include "testing/shard_coordinator.h"
+#include "testing/test_suite.h"
+
+namespace godot::Testing
+{
+    // Runs test suites without the editor, for example from a build server:
+    //
+    //     godot --headless --path <project> res://test_runner.tscn -- --suite=Example* --case=*benchmark*
+    //
+    // When the scene starts, the runner reads its settings from the user arguments on the command
+    // line (after "--"), runs every matching test suite, and quits with exit code 0 if every check
+    // passed, 1 if any check failed or errored, or 2 if no test suites were found.
+    //
+    // With --shards=N, the runner instead splits the matching test cases into N shards and runs
+    // each one in its own headless Godot process (see ShardCoordinator).
+    class TestRunner : public Node
+    {
+        GDCLASS(TestRunner, Node)
+
+    public:
+        static constexpr int EXIT_PASSED = 0;
+        static constexpr int EXIT_FAILED = 1;
+        static constexpr int EXIT_NO_TEST_SUITES = 2;
+
+        virtual void _ready() override;
+        virtual void _process(double delta) override;
+
+        // Runs the matching test suites one after another, and emits finished with the exit code
+        // once they are done (which may be on a later frame if they have asynchronous test cases)
+        void run();
+        bool is_running() const;
+
+        PackedStringArray get_suite_filter() const;
+        void set_suite_filter(const PackedStringArray& suite_filter);
+
+        PackedStringArray get_test_case_filter() const;
+        void set_test_case_filter(const PackedStringArray& test_case_filter);
+
+        PackedStringArray get_test_scenes() const;
+        void set_test_scenes(const PackedStringArray& test_scenes);
+
+        bool get_parallel() const;
+        void set_parallel(bool parallel);
+
+        bool get_suppress_details() const;
+        void set_suppress_details(bool suppress_details);
+
+        String get_junit_path() const;
+        void set_junit_path(const String& junit_path);
+
+        String get_json_path() const;
+        void set_json_path(const String& json_path);
+
+        std::int64_t get_shard_count() const;
+        void set_shard_count(std::int64_t shard_count);
+
+        String get_results_cache_path() const;
+        void set_results_cache_path(const String& results_cache_path);
+
+        bool get_failed_first() const;
+        void set_failed_first(bool failed_first);
+
+        bool get_fail_fast() const;
+        void set_fail_fast(bool fail_fast);
+
+        bool get_record_impact() const;
+        void set_record_impact(bool record_impact);
+
+        bool get_affected_only() const;
+        void set_affected_only(bool affected_only);
+
+        String get_impact_map_path() const;
+        void set_impact_map_path(const String& impact_map_path);
+
+        bool get_quit_when_done() const;
+        void set_quit_when_done(bool quit_when_done);
+
+        int get_exit_code() const;
+
+    protected:
+        static void _bind_methods();
+        void _notification(int p_what);
+
+    private:
+        // Returns false if the command line could not be parsed
+        bool parse_command_line();
+        void run_and_quit();
+        void run_next_test_suites();
+        void on_test_suite_finished();
+        void on_test_suite_done(TestSuite* test_suite);
+        void finish();
+
+        void run_sharded();
+        void finish_sharded_run();
+        // Restricts this worker to the test cases of its shard. Returns false if the plan could not
+        // be read.
+        bool load_shard_plan();
+
+        std::vector<TestSuite*> load_test_suites();
+        void find_scene_paths(const String& path, PackedStringArray& r_scene_paths) const;
+        bool matches_suite_filter(const String& test_suite_class) const;
+
+        PackedStringArray m_suite_filter;
+        PackedStringArray m_test_case_filter;
+        // Scene files or directories to search for test suites. If empty, every registered test
+        // suite class is instantiated instead.
+        PackedStringArray m_test_scenes;
+
+        // If set, the results of all test suites are also written to these files
+        String m_junit_path;
+        String m_json_path;
+
+        bool m_parallel = false;
+        bool m_time_checks = false;
+        bool m_suppress_details = true;
+        bool m_list_only = false;
+        // Runs the test cases that did not pass last time first, then the rest shortest first
+        bool m_failed_first = false;
+        // Stops at the first test case that fails or errors
+        bool m_fail_fast = false;
+        bool m_stopped_early = false;
+        // Set by --update-baselines, which sharded runs reject
+        bool m_update_baselines = false;
+        // Records the source files each test case covers, or only runs the test cases affected by
+        // changes since then (see TestImpactMap)
+        bool m_record_impact = false;
+        bool m_affected_only = false;
+        String m_impact_map_path = TestImpactMap::DEFAULT_PATH;
+        bool m_quit_when_done = true;
+
+        // More than one shard makes this runner a coordinator for worker processes
+        std::int64_t m_shard_count = 0;
+        String m_results_cache_path = TestResultCache::DEFAULT_PATH;
+        // The arguments forwarded to each worker
+        PackedStringArray m_worker_arguments;
+        Ref<ShardCoordinator> m_shard_coordinator;
+
+        // Set when this runner is a worker: its shard of the plan written by the coordinator
+        String m_shard_plan_path;
+        std::int64_t m_shard_index = -1;
+        Dictionary m_shard_test_cases;
+
+        // The test suites and test scenes added as children, which are freed after the run
+        std::vector<Node*> m_loaded_nodes;
+
+        int m_exit_code = EXIT_PASSED;
+
+        bool m_running = false;
+        Ref<OutputSink> m_output_sink;
+        TypedArray<ReportWriter> m_report_writers;
+        std::vector<TestSuite*> m_test_suites;
+        std::size_t m_next_test_suite_index = 0;
+        std::int64_t m_failed_test_suites = 0;
+        TypedArray<ReportWriter> m_previous_report_writers;
+    };
+}
+
+#endif
@@ -1,41 +1,288 @@
 #include "testing/test_suite.h"
 
 #include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/classes/class_db_singleton.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
 
 namespace godot::Testing
 {
     void TestSuite::run_all_test_cases()
     {
-        UtilityFunctions::print_rich(LINE);
-        UtilityFunctions::print_rich(vformat("\n%s%s%s running...\n", TEST_NAME_START, this->get_class(), TEST_NAME_END));
-        UtilityFunctions::print_rich(LINE);
+        ERR_FAIL_COND_MSG(is_running(), "A run of this test suite is already in progress.");
+
+        m_run_test_cases = begin_run();
+        // Coverage counters are shared by the whole process, so recording needs one test case at a time
+        m_ran_in_parallel = m_parallel && !m_record_impact;
+
+        std::vector<Ref<TestCase>> test_cases = get_synchronous_test_cases(m_run_test_cases);
+        std::vector<Ref<TestCase>> completed_test_cases;
+        if (m_ran_in_parallel)
+            completed_test_cases = run_test_cases_in_parallel(test_cases);
+        else
+        {
+            for (const Ref<TestCase>& test_case : test_cases)
+            {
+                run_test_case_serially(test_case);
+                completed_test_cases.push_back(test_case);
+                if (should_stop_after(test_case))
+                    break;
+            }
+        }
+
+        // Asynchronous test cases are not started once the run has stopped early
+        if (m_stopped_early)
+            m_run_test_cases = std::move(completed_test_cases);
+        start_async_test_cases();
+    }
+
+    void TestSuite::start_incremental_run()
+    {
+        ERR_FAIL_COND_MSG(is_running(), "A run of this test suite is already in progress.");
+
+        // Incremental runs always run their test cases one after another on the main thread
+        m_run_test_cases = begin_run();
+        m_ran_in_parallel = false;
+
+        std::vector<Ref<TestCase>> test_cases = get_synchronous_test_cases(m_run_test_cases);
+        if (test_cases.empty())
+        {
+            start_async_test_cases();
+            return;
+        }
+
+        m_incremental_test_cases = std::move(test_cases);
+        m_incremental_next_index = 0;
+        m_incremental_run_active = true;
+        set_process(true);
+    }
+
+    void TestSuite::cancel_run()
+    {
+        if (m_incremental_run_active)
+        {
+            std::vector<Ref<TestCase>> completed_test_cases(m_incremental_test_cases.begin(), m_incremental_test_cases.begin() + m_incremental_next_index);
+            m_output_sink->print_line(vformat("\n%s%s%s cancelled after %s of %s test cases\n",
+                TEST_NAME_START, this->get_class(), TEST_NAME_END, completed_test_cases.size(), m_run_test_cases.size()));
+            stop_incremental_run();
+            m_run_test_cases.clear();
+            finish_run(completed_test_cases, true);
+        }
+        else if (m_pending_async_test_cases > 0)
+        {
+            // Each cancelled test case completes, and the last one to do so finishes the run
+            m_cancelling = true;
+            for (const Ref<TestCase>& test_case : m_async_test_cases)
+            {
+                AsyncTestCase* async_test_case = Object::cast_to<AsyncTestCase>(test_case.ptr());
+                if (async_test_case->is_running())
+                    async_test_case->cancel();
+            }
+        }
+    }
+
+    bool TestSuite::is_running() const
+    {
+        return m_incremental_run_active || m_pending_async_test_cases > 0;
+    }
+
+    void TestSuite::_process(double delta)
+    {
+        if (!m_incremental_run_active)
+        {
+            set_process(false);
+            return;
+        }
+
+        // Run at least one test case per frame, then keep going while the frame budget allows
+        std::uint64_t frame_start_usec = Time::get_singleton()->get_ticks_usec();
+        do
+        {
+            Ref<TestCase> test_case = m_incremental_test_cases[m_incremental_next_index];
+            run_test_case_serially(test_case);
+            m_output_sink->flush();
+            m_incremental_next_index++;
+            emit_signal("run_progressed", std::int64_t(m_incremental_next_index), std::int64_t(m_run_test_cases.size()), test_case->get_class());
+
+            // A signal handler may have cancelled the run
+            if (!m_incremental_run_active)
+                return;
+
+            if (should_stop_after(test_case))
+            {
+                m_run_test_cases.assign(m_incremental_test_cases.begin(), m_incremental_test_cases.begin() + m_incremental_next_index);
+                stop_incremental_run();
+                start_async_test_cases();
+                return;
+            }
+        }
+        while (m_incremental_next_index < m_incremental_test_cases.size() &&
+            Time::get_singleton()->get_ticks_usec() - frame_start_usec < std::uint64_t(m_frame_budget_usec));
+
+        if (m_incremental_next_index >= m_incremental_test_cases.size())
+        {
+            stop_incremental_run();
+            start_async_test_cases();
+        }
+    }
+
+    void TestSuite::stop_incremental_run()
+    {
+        m_incremental_run_active = false;
+        m_incremental_test_cases.clear();
+        m_incremental_next_index = 0;
+        set_process(false);
+    }
+
+    std::vector<Ref<TestCase>> TestSuite::get_synchronous_test_cases(const std::vector<Ref<TestCase>>& test_cases) const
+    {
+        std::vector<Ref<TestCase>> synchronous_test_cases;
+        for (const Ref<TestCase>& test_case : test_cases)
+        {
+            if (Object::cast_to<AsyncTestCase>(test_case.ptr()) == nullptr)
+                synchronous_test_cases.push_back(test_case);
+        }
+        return synchronous_test_cases;
+    }
+
+    void TestSuite::start_async_test_cases()
+    {
+        m_async_test_cases.clear();
+        for (const Ref<TestCase>& test_case : m_run_test_cases)
+        {
+            if (Object::cast_to<AsyncTestCase>(test_case.ptr()) != nullptr)
+                m_async_test_cases.push_back(test_case);
+        }
+
+        if (m_async_test_cases.empty())
+        {
+            std::vector<Ref<TestCase>> test_cases = std::move(m_run_test_cases);
+            finish_run(test_cases);
+            return;
+        }
+
+        // All asynchronous test cases wait at the same time, so each buffers its output like in a parallel run
+        m_pending_async_test_cases = m_async_test_cases.size();
+        m_async_previous_settings.clear();
+        for (const Ref<TestCase>& test_case : m_async_test_cases)
+        {
+            m_async_previous_settings.push_back({test_case->get_suppress_details(), test_case->get_time_checks(), test_case->get_output_sink()});
+            test_case->set_suppress_details(m_suppress_details);
+            test_case->set_time_checks(m_time_checks || test_case->get_time_checks());
+            test_case->set_output_sink(create_buffer_output_sink());
+            test_case->connect("completed", callable_mp(this, &TestSuite::on_async_test_case_completed), CONNECT_ONE_SHOT);
+        }
+
+        // Copy the list, since the last test case to complete clears it
+        std::vector<Ref<TestCase>> async_test_cases = m_async_test_cases;
+        for (const Ref<TestCase>& test_case : async_test_cases)
+            test_case->run(false);
+    }
+
+    void TestSuite::on_async_test_case_completed()
+    {
+        m_pending_async_test_cases--;
+        emit_signal("run_progressed", std::int64_t(m_run_test_cases.size() - m_pending_async_test_cases), std::int64_t(m_run_test_cases.size()), String());
+        if (m_pending_async_test_cases > 0)
+            return;
+
+        for (std::size_t i = 0; i < m_async_test_cases.size(); ++i)
+        {
+            const Ref<TestCase>& test_case = m_async_test_cases[i];
+            const TestCaseSettings& previous_settings = m_async_previous_settings[i];
+            test_case->get_output_sink()->forward_to(m_output_sink);
+            test_case->set_output_sink(previous_settings.output_sink);
+            test_case->set_suppress_details(previous_settings.suppress_details);
+            test_case->set_time_checks(previous_settings.time_checks);
+
+            count_test_case_results(test_case);
+            write_test_case_report(test_case);
+        }
+        m_async_test_cases.clear();
+        m_async_previous_settings.clear();
+
+        bool cancelled = m_cancelling;
+        m_cancelling = false;
+        std::vector<Ref<TestCase>> test_cases = std::move(m_run_test_cases);
+        finish_run(test_cases, cancelled);
+    }
+
+    Ref<OutputSink> TestSuite::create_buffer_output_sink() const
+    {
+        Ref<OutputSink> buffer_output_sink;
+        buffer_output_sink.instantiate();
+        buffer_output_sink->set_plain_text(m_output_sink->get_plain_text());
+        buffer_output_sink->set_flush_line_count(0);
+        buffer_output_sink->set_flush_interval_usec(0);
+        return buffer_output_sink;
+    }
+
+    std::vector<Ref<TestCase>> TestSuite::begin_run()
+    {
+        m_output_sink->print_line(LINE);
+        m_output_sink->print_line(vformat("\n%s%s%s running...\n", TEST_NAME_START, this->get_class(), TEST_NAME_END));
+        m_output_sink->print_line(LINE);
 
         m_passed_test_cases = 0;
         m_mixed_test_cases = 0;
         m_failed_test_cases = 0;
         m_errored_test_cases = 0;
+        m_stopped_early = false;
+        m_parallel_leaked = false;
 
-        for (const auto& [_, test_case] : m_all_test_cases)
+        for (std::int64_t i = 0; i < m_report_writers.size(); ++i)
         {
-            if (!test_case.is_valid())
-                continue;
+            Ref<ReportWriter> report_writer = m_report_writers[i];
+            if (report_writer.is_valid())
+                report_writer->begin_test_suite(this->get_class());
+        }
 
-            bool previous_suppress_details = test_case->get_suppress_details();
-            test_case->set_suppress_details(m_suppress_details);
-            test_case->run();
-            test_case->set_suppress_details(previous_suppress_details);
+        std::vector<Ref<TestCase>> test_cases;
+        TypedArray<TestCase> selected_test_cases = get_selected_test_cases();
+        for (std::int64_t i = 0; i < selected_test_cases.size(); ++i)
+            test_cases.push_back(selected_test_cases[i]);
 
-            if (test_case->get_failed_checks() == 0)
-                m_passed_test_cases++;
-            else if (test_case->get_passed_checks() == 0)
-                m_failed_test_cases++;
-            else
-                m_mixed_test_cases++;
+        m_impact_map.unref();
+        if (m_record_impact || m_affected_only)
+        {
+            m_impact_map.instantiate();
+            m_impact_map->load(m_impact_map_path);
+        }
 
-            if (test_case->get_errored_checks() > 0)
-                m_errored_test_cases++;
+        if (m_affected_only)
+        {
+            PackedStringArray changed_files = m_impact_map->get_changed_files();
+            std::size_t selected_count = test_cases.size();
+            test_cases.erase(std::remove_if(test_cases.begin(), test_cases.end(), [&](const Ref<TestCase>& test_case)
+            {
+                return !m_impact_map->is_affected(TestResultCache::make_key(this->get_class(), test_case->get_class()), changed_files);
+            }), test_cases.end());
+            m_output_sink->print_line(vformat("%s files changed since the impact map was recorded, skipping %s unaffected test cases\n",
+                changed_files.size(), std::int64_t(selected_count - test_cases.size())));
         }
 
+        m_result_cache.unref();
+        if (m_use_result_cache)
+        {
+            m_result_cache.instantiate();
+            m_result_cache->load(m_result_cache_path);
+            order_by_result_cache(test_cases);
+        }
+
+        m_run_start_usec = Time::get_singleton()->get_ticks_usec();
+        return test_cases;
+    }
+
+    void TestSuite::finish_run(const std::vector<Ref<TestCase>>& test_cases, bool cancelled)
+    {
+        m_wall_clock_usec = Time::get_singleton()->get_ticks_usec() - m_run_start_usec;
+
+        std::int64_t total_duration_usec = 0;
+        for (const Ref<TestCase>& test_case : test_cases)
+            total_duration_usec += test_case->get_duration_usec();
+        m_speedup = m_wall_clock_usec > 0 ? double(total_duration_usec) / double(m_wall_clock_usec) : 1.0;
+
         String test_suite_results;
 
         if (m_failed_test_cases == 0 && m_mixed_test_cases == 0)
@@ -48,13 +295,443 @@ namespace godot::Testing
         if (m_errored_test_cases > 0)
             test_suite_results += vformat(" %swith errors%s", ERRORED_START, ERRORED_END);
 
-        UtilityFunctions::print_rich(LINE);
-        UtilityFunctions::print_rich(vformat("\n%s%s%s results: %s", TEST_NAME_START, this->get_class(), TEST_NAME_END, test_suite_results));
-        UtilityFunctions::print_rich(vformat("    test cases passed: %s%s%s", PASSED_START, m_passed_test_cases, PASSED_END));
-        UtilityFunctions::print_rich(vformat("    test cases mixed: %s%s%s", MIXED_START, m_mixed_test_cases, MIXED_END));
-        UtilityFunctions::print_rich(vformat("    test cases failed: %s%s%s", FAILED_START, m_failed_test_cases, FAILED_END));
-        UtilityFunctions::print_rich(vformat("    test cases with unexpected errors: %s%s%s\n", ERRORED_START, m_errored_test_cases, ERRORED_END));
-        UtilityFunctions::print_rich(LINE);
+        m_output_sink->print_line(LINE);
+        m_output_sink->print_line(vformat("\n%s%s%s results: %s", TEST_NAME_START, this->get_class(), TEST_NAME_END, test_suite_results));
+        m_output_sink->print_line(vformat("    test cases passed: %s%s%s", PASSED_START, m_passed_test_cases, PASSED_END));
+        m_output_sink->print_line(vformat("    test cases mixed: %s%s%s", MIXED_START, m_mixed_test_cases, MIXED_END));
+        m_output_sink->print_line(vformat("    test cases failed: %s%s%s", FAILED_START, m_failed_test_cases, FAILED_END));
+        m_output_sink->print_line(vformat("    test cases with unexpected errors: %s%s%s", ERRORED_START, m_errored_test_cases, ERRORED_END));
+        if (m_stopped_early)
+            m_output_sink->print_line(vformat("    %sstopped after the first failure%s (fail_fast)", FAILED_START, FAILED_END));
+        if (m_parallel_leaked)
+        {
+            m_output_sink->print_line(vformat("    %sthe parallel test cases leaked%s %s objects and %s orphan nodes (static memory %+d bytes)", ERRORED_START, ERRORED_END,
+                m_parallel_leak_growth.objects, m_parallel_leak_growth.orphan_nodes, m_parallel_leak_growth.static_memory));
+        }
+        m_output_sink->print_line(vformat("    wall-clock time: %.3f ms", m_wall_clock_usec / 1000.0));
+        if (m_ran_in_parallel)
+            m_output_sink->print_line(vformat("    speedup: %.2fx", m_speedup));
+        if (m_slowest_count > 0)
+            print_slowest(test_cases);
+        if (m_watch)
+            compare_with_previous_results(test_cases);
+        m_output_sink->print_line("");
+        m_output_sink->print_line(LINE);
+        m_output_sink->flush();
+
+        for (std::int64_t i = 0; i < m_report_writers.size(); ++i)
+        {
+            Ref<ReportWriter> report_writer = m_report_writers[i];
+            if (report_writer.is_valid())
+                report_writer->end_test_suite(m_wall_clock_usec);
+        }
+
+        if (m_result_cache.is_valid())
+        {
+            record_in_result_cache(test_cases);
+            m_result_cache.unref();
+        }
+
+        if (m_impact_map.is_valid())
+        {
+            if (m_record_impact)
+            {
+                Error error = m_impact_map->save();
+                if (error != OK)
+                    UtilityFunctions::push_warning(vformat("Could not save the test impact map to %s: %s", m_impact_map_path, UtilityFunctions::error_string(error)));
+            }
+            m_impact_map.unref();
+        }
+
+        if (cancelled)
+            emit_signal("run_cancelled");
+        else
+            emit_signal("run_finished");
+    }
+
+    void TestSuite::run_test_case_serially(const Ref<TestCase>& test_case)
+    {
+        bool previous_suppress_details = test_case->get_suppress_details();
+        bool previous_time_checks = test_case->get_time_checks();
+        Ref<OutputSink> previous_output_sink = test_case->get_output_sink();
+        test_case->set_suppress_details(m_suppress_details);
+        test_case->set_time_checks(m_time_checks || previous_time_checks);
+        test_case->set_output_sink(m_output_sink);
+        if (m_record_impact)
+        {
+            m_impact_map->begin_recording();
+            test_case->run(false);
+            m_impact_map->end_recording(TestResultCache::make_key(this->get_class(), test_case->get_class()));
+        }
+        else
+        {
+            test_case->run(false);
+        }
+        test_case->set_suppress_details(previous_suppress_details);
+        test_case->set_time_checks(previous_time_checks);
+        test_case->set_output_sink(previous_output_sink);
+
+        count_test_case_results(test_case);
+        write_test_case_report(test_case);
+    }
+
+    std::vector<Ref<TestCase>> TestSuite::run_test_cases_in_parallel(const std::vector<Ref<TestCase>>& test_cases)
+    {
+        std::vector<bool> previous_suppress_details;
+        std::vector<bool> previous_time_checks;
+        std::vector<bool> previous_check_leaks;
+        std::vector<Ref<OutputSink>> previous_output_sinks;
+        bool check_leaks = false;
+        // The batch is allowed as much static memory growth as the most lenient test case that checks
+        std::int64_t max_static_memory_growth = 0;
+        m_parallel_test_cases.clear();
+        for (const Ref<TestCase>& test_case : test_cases)
+        {
+            previous_suppress_details.push_back(test_case->get_suppress_details());
+            previous_time_checks.push_back(test_case->get_time_checks());
+            previous_check_leaks.push_back(test_case->get_check_leaks());
+            previous_output_sinks.push_back(test_case->get_output_sink());
+            test_case->set_suppress_details(m_suppress_details);
+            test_case->set_time_checks(m_time_checks || previous_time_checks.back());
+            if (previous_check_leaks.back() && TestCase::get_leak_checks_enabled())
+            {
+                check_leaks = true;
+                max_static_memory_growth = std::max(max_static_memory_growth, test_case->get_max_static_memory_growth());
+            }
+            test_case->set_check_leaks(false);
+
+            // Each test case buffers its whole output until all test cases are done
+            test_case->set_output_sink(create_buffer_output_sink());
+
+            if (test_case->get_thread_safe())
+                m_parallel_test_cases.push_back(test_case);
+        }
+        m_parallel_test_cases_ran.assign(m_parallel_test_cases.size(), 0);
+        m_parallel_stop = false;
+
+        LeakSnapshot leak_snapshot_before;
+        if (check_leaks)
+            leak_snapshot_before = LeakSnapshot::take();
+
+        WorkerThreadPool* worker_thread_pool = WorkerThreadPool::get_singleton();
+        std::int64_t group_id = -1;
+        if (!m_parallel_test_cases.empty())
+        {
+            group_id = worker_thread_pool->add_group_task(
+                callable_mp(this, &TestSuite::run_parallel_test_case),
+                m_parallel_test_cases.size(), -1, true, vformat("%s test cases", this->get_class()));
+        }
+
+        // Test cases that are not thread-safe run on the main thread while the others are in progress
+        std::vector<bool> ran(test_cases.size(), false);
+        for (std::size_t i = 0; i < test_cases.size(); ++i)
+        {
+            if (test_cases[i]->get_thread_safe() || m_parallel_stop)
+                continue;
+            test_cases[i]->run(false);
+            ran[i] = true;
+            if (m_fail_fast && (test_cases[i]->get_failed_checks() > 0 || test_cases[i]->get_errored_checks() > 0))
+                m_parallel_stop = true;
+        }
+
+        if (group_id >= 0)
+            worker_thread_pool->wait_for_group_task_completion(group_id);
+
+        if (check_leaks)
+        {
+            LeakSnapshot leak_snapshot_after = LeakSnapshot::take();
+            m_parallel_leak_growth.objects = leak_snapshot_after.objects - leak_snapshot_before.objects;
+            m_parallel_leak_growth.orphan_nodes = leak_snapshot_after.orphan_nodes - leak_snapshot_before.orphan_nodes;
+            m_parallel_leak_growth.static_memory = leak_snapshot_after.static_memory - leak_snapshot_before.static_memory;
+            m_parallel_leaked = m_parallel_leak_growth.objects > 0 || m_parallel_leak_growth.orphan_nodes > 0 || m_parallel_leak_growth.static_memory > max_static_memory_growth;
+        }
+
+        for (std::size_t i = 0, j = 0; i < test_cases.size(); ++i)
+        {
+            if (test_cases[i]->get_thread_safe())
+                ran[i] = m_parallel_test_cases_ran[j++] != 0;
+        }
+        m_parallel_test_cases.clear();
+        m_parallel_test_cases_ran.clear();
+        m_stopped_early = m_parallel_stop;
+
+        // Emit the buffered output of each test case in the order it was scheduled
+        std::vector<Ref<TestCase>> completed_test_cases;
+        for (std::size_t i = 0; i < test_cases.size(); ++i)
+        {
+            const Ref<TestCase>& test_case = test_cases[i];
+            test_case->get_output_sink()->forward_to(m_output_sink);
+            test_case->set_output_sink(previous_output_sinks[i]);
+            test_case->set_suppress_details(previous_suppress_details[i]);
+            test_case->set_time_checks(previous_time_checks[i]);
+            test_case->set_check_leaks(previous_check_leaks[i]);
+
+            if (!ran[i])
+                continue;
+            count_test_case_results(test_case);
+            write_test_case_report(test_case);
+            completed_test_cases.push_back(test_case);
+        }
+
+        if (m_parallel_leaked)
+            report_parallel_leaks();
+        return completed_test_cases;
+    }
+
+    void TestSuite::report_parallel_leaks()
+    {
+        // The growth cannot be pinned on one test case, so the batch counts as an errored test
+        // case of its own, and is reported as one
+        m_errored_test_cases++;
+
+        Ref<TestReport> report;
+        report.instantiate();
+        report->set_test_case_name("ParallelTestCases");
+        report->add_check("CHECK_NO_LEAKS(parallel test cases)", __FILE__, __LINE__, CHECK_ERRORED, 1, 0,
+            vformat("        objects: %+d\n        orphan nodes: %+d\n        static memory: %+d bytes",
+                m_parallel_leak_growth.objects, m_parallel_leak_growth.orphan_nodes, m_parallel_leak_growth.static_memory));
+        report->set_check_counts(0, 0, 1);
+        for (std::int64_t i = 0; i < m_report_writers.size(); ++i)
+        {
+            Ref<ReportWriter> report_writer = m_report_writers[i];
+            if (report_writer.is_valid())
+                report_writer->write_test_case(report);
+        }
+    }
+
+    void TestSuite::run_parallel_test_case(std::uint32_t index)
+    {
+        // Once fail_fast has stopped the run, the remaining test cases are skipped
+        if (m_parallel_stop)
+            return;
+
+        const Ref<TestCase>& test_case = m_parallel_test_cases[index];
+        test_case->run(false);
+        m_parallel_test_cases_ran[index] = 1;
+        if (m_fail_fast && (test_case->get_failed_checks() > 0 || test_case->get_errored_checks() > 0))
+            m_parallel_stop = true;
+    }
+
+    void TestSuite::count_test_case_results(const Ref<TestCase>& test_case)
+    {
+        if (test_case->get_failed_checks() == 0)
+            m_passed_test_cases++;
+        else if (test_case->get_passed_checks() == 0)
+            m_failed_test_cases++;
+        else
+            m_mixed_test_cases++;
+
+        if (test_case->get_errored_checks() > 0)
+            m_errored_test_cases++;
+    }
+
+    bool TestSuite::should_stop_after(const Ref<TestCase>& test_case)
+    {
+        if (m_fail_fast && (test_case->get_failed_checks() > 0 || test_case->get_errored_checks() > 0))
+            m_stopped_early = true;
+        return m_stopped_early;
+    }
+
+    void TestSuite::order_by_result_cache(std::vector<Ref<TestCase>>& test_cases) const
+    {
+        // Test cases that have never run count as taking the typical time
+        std::int64_t typical_duration_usec = m_result_cache->get_typical_duration_usec();
+
+        struct ScheduledTestCase
+        {
+            bool failed_last_time;
+            std::int64_t duration_usec;
+            Ref<TestCase> test_case;
+        };
+
+        std::vector<ScheduledTestCase> scheduled_test_cases;
+        scheduled_test_cases.reserve(test_cases.size());
+        for (const Ref<TestCase>& test_case : test_cases)
+        {
+            String key = TestResultCache::make_key(this->get_class(), test_case->get_class());
+            String last_result = m_result_cache->get_result(key);
+            bool failed_last_time = !last_result.is_empty() && last_result != "passed";
+            scheduled_test_cases.push_back({failed_last_time, m_result_cache->get_duration_usec(key, typical_duration_usec), test_case});
+        }
+
+        std::stable_sort(scheduled_test_cases.begin(), scheduled_test_cases.end(), [](const ScheduledTestCase& a, const ScheduledTestCase& b)
+        {
+            if (a.failed_last_time != b.failed_last_time)
+                return a.failed_last_time;
+            return a.duration_usec < b.duration_usec;
+        });
+
+        for (std::size_t i = 0; i < test_cases.size(); ++i)
+            test_cases[i] = scheduled_test_cases[i].test_case;
+    }
+
+    void TestSuite::record_in_result_cache(const std::vector<Ref<TestCase>>& test_cases)
+    {
+        for (const Ref<TestCase>& test_case : test_cases)
+        {
+            Ref<TestReport> report = test_case->get_report();
+            m_result_cache->record(TestResultCache::make_key(this->get_class(), test_case->get_class()), report->get_result(), report->get_duration_usec());
+        }
+
+        Error error = m_result_cache->save();
+        if (error != OK)
+            UtilityFunctions::printerr(vformat("Could not save the test result cache to %s: %s", m_result_cache_path, UtilityFunctions::error_string(error)));
+    }
+
+    void TestSuite::_notification(int p_what)
+    {
+        if (p_what == NOTIFICATION_EXTENSION_RELOADED && m_watch)
+        {
+            // Let the rest of the reload finish (such as restoring the test cases) first
+            callable_mp(this, &TestSuite::run_after_reload).call_deferred();
+        }
+    }
+
+    void TestSuite::run_after_reload()
+    {
+        if (is_running())
+            return;
+
+        m_output_sink->print_line(vformat("%s%s%s was reloaded, running it again", TEST_NAME_START, this->get_class(), TEST_NAME_END));
+        run_all_test_cases();
+    }
+
+    void TestSuite::compare_with_previous_results(const std::vector<Ref<TestCase>>& test_cases)
+    {
+        Ref<TestResultCache> watch_results;
+        watch_results.instantiate();
+        watch_results->load(WATCH_RESULTS_PATH);
+
+        m_previous_results.clear();
+        PackedStringArray changes;
+        for (const Ref<TestCase>& test_case : test_cases)
+        {
+            String key = TestResultCache::make_key(this->get_class(), test_case->get_class());
+            String result = test_case->get_report()->get_result();
+            if (watch_results->has_entry(key))
+            {
+                String previous_result = watch_results->get_result(key);
+                m_previous_results[test_case->get_class()] = previous_result;
+                if (previous_result != result)
+                    changes.push_back(vformat("        %s: %s -> %s", test_case->get_class(), previous_result, result));
+            }
+            watch_results->record(key, result, test_case->get_duration_usec());
+        }
+        Error error = watch_results->save();
+        if (error != OK)
+            UtilityFunctions::printerr(vformat("Could not save the results of this run to %s: %s", WATCH_RESULTS_PATH, UtilityFunctions::error_string(error)));
+
+        if (m_previous_results.is_empty())
+            return;
+
+        if (changes.is_empty())
+        {
+            m_output_sink->print_line("    no test case results changed since the previous run");
+            return;
+        }
+
+        m_output_sink->print_line(vformat("    %s test case results changed since the previous run:", changes.size()));
+        for (std::int64_t i = 0; i < changes.size(); ++i)
+            m_output_sink->print_line(changes[i]);
+    }
+
+    void TestSuite::print_slowest(const std::vector<Ref<TestCase>>& test_cases)
+    {
+        std::vector<Ref<TestCase>> slowest_test_cases = test_cases;
+        std::size_t test_case_count = std::min<std::size_t>(m_slowest_count, slowest_test_cases.size());
+        std::partial_sort(slowest_test_cases.begin(), slowest_test_cases.begin() + test_case_count, slowest_test_cases.end(),
+            [](const Ref<TestCase>& a, const Ref<TestCase>& b) { return a->get_duration_usec() > b->get_duration_usec(); });
+
+        m_output_sink->print_line(vformat("    slowest %s test cases:", test_case_count));
+        for (std::size_t i = 0; i < test_case_count; ++i)
+        {
+            m_output_sink->print_line(vformat("        %s: %s",
+                slowest_test_cases[i]->get_class(), format_nsec(slowest_test_cases[i]->get_duration_usec() * 1000.0)));
+        }
+
+        // Checks only have durations if they were timed
+        std::vector<std::pair<const CheckRecord*, String>> slowest_checks;
+        for (const Ref<TestCase>& test_case : test_cases)
+        {
+            for (const CheckRecord& record : test_case->get_report()->get_check_records())
+            {
+                if (record.duration_nsec > 0)
+                    slowest_checks.push_back({&record, test_case->get_class()});
+            }
+        }
+        if (slowest_checks.empty())
+            return;
+
+        std::size_t check_count = std::min<std::size_t>(m_slowest_count, slowest_checks.size());
+        std::partial_sort(slowest_checks.begin(), slowest_checks.begin() + check_count, slowest_checks.end(),
+            [](const auto& a, const auto& b) { return a.first->duration_nsec > b.first->duration_nsec; });
+
+        m_output_sink->print_line(vformat("    slowest %s checks:", check_count));
+        for (std::size_t i = 0; i < check_count; ++i)
+        {
+            const auto& [record, test_case_class] = slowest_checks[i];
+            m_output_sink->print_line(vformat("        %s in %s at %s:%s: %s",
+                record->check_string, test_case_class, record->file, record->line, format_nsec(double(record->duration_nsec))));
+        }
+    }
+
+    void TestSuite::write_test_case_report(const Ref<TestCase>& test_case)
+    {
+        for (std::int64_t i = 0; i < m_report_writers.size(); ++i)
+        {
+            Ref<ReportWriter> report_writer = m_report_writers[i];
+            if (report_writer.is_valid())
+                report_writer->write_test_case(test_case->get_report());
+        }
+    }
+
+    bool TestSuite::matches_test_case_filter(const String& test_case_name, const Ref<TestCase>& test_case) const
+    {
+        if (m_test_case_filter.is_empty())
+            return true;
+
+        String test_case_class = test_case->get_class();
+        for (std::int64_t i = 0; i < m_test_case_filter.size(); ++i)
+        {
+            if (test_case_name.match(m_test_case_filter[i]) || test_case_class.match(m_test_case_filter[i]))
+                return true;
+        }
+        return false;
+    }
+
+    TypedArray<TestCase> TestSuite::get_selected_test_cases() const
+    {
+        TypedArray<TestCase> selected_test_cases;
+        for (const auto& [test_case_name, test_case] : m_all_test_cases)
+        {
+            if (test_case.is_valid() && matches_test_case_filter(test_case_name, test_case))
+                selected_test_cases.push_back(test_case);
+        }
+        return selected_test_cases;
+    }
+
+    void TestSuite::instantiate_missing_test_cases()
+    {
+        ClassDBSingleton* class_db = ClassDBSingleton::get_singleton();
+        TypedArray<Dictionary> property_list = get_property_list();
+        for (std::int64_t i = 0; i < property_list.size(); ++i)
+        {
+            Dictionary property = property_list[i];
+            if (int(property["type"]) != Variant::OBJECT || int(property["hint"]) != PROPERTY_HINT_RESOURCE_TYPE)
+                continue;
+
+            String property_name = property["name"];
+            String test_case_class = property["hint_string"];
+            if (get(property_name).get_type() != Variant::NIL || !class_db->is_parent_class(test_case_class, "TestCase") || !class_db->can_instantiate(test_case_class))
+                continue;
+
+            set(property_name, class_db->instantiate(test_case_class));
+        }
+    }
+
+    TestSuite::TestSuite()
+    {
+        m_output_sink.instantiate();
     }
 
     Callable TestSuite::get_all_test_cases_runner()
@@ -62,6 +739,21 @@ namespace godot::Testing
         return m_all_test_cases_runner;
     }
 
+    Callable TestSuite::get_incremental_runner()
+    {
+        return m_incremental_runner;
+    }
+
+    std::int64_t TestSuite::get_frame_budget_usec() const
+    {
+        return m_frame_budget_usec;
+    }
+
+    void TestSuite::set_frame_budget_usec(std::int64_t frame_budget_usec)
+    {
+        m_frame_budget_usec = frame_budget_usec;
+    }
+
     bool TestSuite::get_suppress_details() const
     {
         return m_suppress_details;
@@ -72,6 +764,144 @@ namespace godot::Testing
         m_suppress_details = suppress_details;
     }
 
+    bool TestSuite::get_time_checks() const
+    {
+        return m_time_checks;
+    }
+
+    void TestSuite::set_time_checks(bool time_checks)
+    {
+        m_time_checks = time_checks;
+    }
+
+    std::int64_t TestSuite::get_slowest_count() const
+    {
+        return m_slowest_count;
+    }
+
+    void TestSuite::set_slowest_count(std::int64_t slowest_count)
+    {
+        m_slowest_count = slowest_count;
+    }
+
+    Ref<OutputSink> TestSuite::get_output_sink() const
+    {
+        return m_output_sink;
+    }
+
+    void TestSuite::set_output_sink(const Ref<OutputSink>& output_sink)
+    {
+        m_output_sink = output_sink;
+    }
+
+    PackedStringArray TestSuite::get_test_case_names() const
+    {
+        PackedStringArray test_case_names;
+        for (const auto& [test_case_name, _] : m_all_test_cases)
+            test_case_names.push_back(test_case_name);
+        return test_case_names;
+    }
+
+    PackedStringArray TestSuite::get_test_case_filter() const
+    {
+        return m_test_case_filter;
+    }
+
+    void TestSuite::set_test_case_filter(const PackedStringArray& test_case_filter)
+    {
+        m_test_case_filter = test_case_filter;
+    }
+
+    bool TestSuite::get_use_result_cache() const
+    {
+        return m_use_result_cache;
+    }
+
+    void TestSuite::set_use_result_cache(bool use_result_cache)
+    {
+        m_use_result_cache = use_result_cache;
+    }
+
+    String TestSuite::get_result_cache_path() const
+    {
+        return m_result_cache_path;
+    }
+
+    void TestSuite::set_result_cache_path(const String& result_cache_path)
+    {
+        m_result_cache_path = result_cache_path;
+    }
+
+    bool TestSuite::get_fail_fast() const
+    {
+        return m_fail_fast;
+    }
+
+    void TestSuite::set_fail_fast(bool fail_fast)
+    {
+        m_fail_fast = fail_fast;
+    }
+
+    bool TestSuite::get_stopped_early() const
+    {
+        return m_stopped_early;
+    }
+
+    bool TestSuite::get_record_impact() const
+    {
+        return m_record_impact;
+    }
+
+    void TestSuite::set_record_impact(bool record_impact)
+    {
+        m_record_impact = record_impact;
+    }
+
+    bool TestSuite::get_affected_only() const
+    {
+        return m_affected_only;
+    }
+
+    void TestSuite::set_affected_only(bool affected_only)
+    {
+        m_affected_only = affected_only;
+    }
+
+    String TestSuite::get_impact_map_path() const
+    {
+        return m_impact_map_path;
+    }
+
+    void TestSuite::set_impact_map_path(const String& impact_map_path)
+    {
+        m_impact_map_path = impact_map_path;
+    }
+
+    bool TestSuite::get_watch() const
+    {
+        return m_watch;
+    }
+
+    void TestSuite::set_watch(bool watch)
+    {
+        m_watch = watch;
+    }
+
+    Dictionary TestSuite::get_previous_results() const
+    {
+        return m_previous_results;
+    }
+
+    bool TestSuite::get_parallel() const
+    {
+        return m_parallel;
+    }
+
+    void TestSuite::set_parallel(bool parallel)
+    {
+        m_parallel = parallel;
+    }
+
     std::int64_t TestSuite::get_passed_test_cases() const
     {
         return m_passed_test_cases;
@@ -92,16 +922,119 @@ namespace godot::Testing
         return m_errored_test_cases;
     }
 
+    std::int64_t TestSuite::get_wall_clock_usec() const
+    {
+        return m_wall_clock_usec;
+    }
+
+    double TestSuite::get_speedup() const
+    {
+        return m_speedup;
+    }
+
+    TypedArray<ReportWriter> TestSuite::get_report_writers() const
+    {
+        return m_report_writers;
+    }
+
+    void TestSuite::set_report_writers(const TypedArray<ReportWriter>& report_writers)
+    {
+        m_report_writers = report_writers;
+    }
+
+    Array TestSuite::get_test_reports() const
+    {
+        Array test_reports;
+        for (const auto& [_, test_case] : m_all_test_cases)
+        {
+            if (test_case.is_valid())
+                test_reports.push_back(test_case->get_report());
+        }
+        return test_reports;
+    }
+
     void TestSuite::_bind_methods()
     {
         ClassDB::bind_method(D_METHOD("run_all_test_cases"), &TestSuite::run_all_test_cases);
         ClassDB::bind_method(D_METHOD("get_all_test_cases_runner"), &TestSuite::get_all_test_cases_runner);
         ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "all_test_cases_runner", PROPERTY_HINT_TOOL_BUTTON, "Run all test cases,Play", PROPERTY_USAGE_EDITOR), "", "get_all_test_cases_runner");
 
+        ClassDB::bind_method(D_METHOD("start_incremental_run"), &TestSuite::start_incremental_run);
+        ClassDB::bind_method(D_METHOD("cancel_run"), &TestSuite::cancel_run);
+        ClassDB::bind_method(D_METHOD("is_running"), &TestSuite::is_running);
+        ClassDB::bind_method(D_METHOD("get_incremental_runner"), &TestSuite::get_incremental_runner);
+        ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "incremental_runner", PROPERTY_HINT_TOOL_BUTTON, "Run all test cases incrementally,Play", PROPERTY_USAGE_EDITOR), "", "get_incremental_runner");
+
+        ClassDB::bind_method(D_METHOD("get_frame_budget_usec"), &TestSuite::get_frame_budget_usec);
+        ClassDB::bind_method(D_METHOD("set_frame_budget_usec", "frame_budget_usec"), &TestSuite::set_frame_budget_usec);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "frame_budget_usec", PROPERTY_HINT_RANGE, "0,100000,1,or_greater,suffix:us"), "set_frame_budget_usec", "get_frame_budget_usec");
+
+        ADD_SIGNAL(MethodInfo("run_progressed", PropertyInfo(Variant::INT, "completed_test_cases"), PropertyInfo(Variant::INT, "total_test_cases"), PropertyInfo(Variant::STRING, "test_case_name")));
+        ADD_SIGNAL(MethodInfo("run_finished"));
+        ADD_SIGNAL(MethodInfo("run_cancelled"));
+
         ClassDB::bind_method(D_METHOD("get_suppress_details"), &TestSuite::get_suppress_details);
         ClassDB::bind_method(D_METHOD("set_suppress_details", "suppress_details"), &TestSuite::set_suppress_details);
         ADD_PROPERTY(PropertyInfo(Variant::BOOL, "suppress_details"), "set_suppress_details", "get_suppress_details");
 
+        ClassDB::bind_method(D_METHOD("get_time_checks"), &TestSuite::get_time_checks);
+        ClassDB::bind_method(D_METHOD("set_time_checks", "time_checks"), &TestSuite::set_time_checks);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "time_checks"), "set_time_checks", "get_time_checks");
+
+        ClassDB::bind_method(D_METHOD("get_slowest_count"), &TestSuite::get_slowest_count);
+        ClassDB::bind_method(D_METHOD("set_slowest_count", "slowest_count"), &TestSuite::set_slowest_count);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "slowest_count", PROPERTY_HINT_RANGE, "0,100,1,or_greater"), "set_slowest_count", "get_slowest_count");
+
+        ClassDB::bind_method(D_METHOD("get_output_sink"), &TestSuite::get_output_sink);
+        ClassDB::bind_method(D_METHOD("set_output_sink", "output_sink"), &TestSuite::set_output_sink);
+
+        ClassDB::bind_method(D_METHOD("get_test_case_names"), &TestSuite::get_test_case_names);
+
+        ClassDB::bind_method(D_METHOD("get_test_case_filter"), &TestSuite::get_test_case_filter);
+        ClassDB::bind_method(D_METHOD("set_test_case_filter", "test_case_filter"), &TestSuite::set_test_case_filter);
+        ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "test_case_filter"), "set_test_case_filter", "get_test_case_filter");
+
+        ClassDB::bind_method(D_METHOD("get_selected_test_cases"), &TestSuite::get_selected_test_cases);
+        ClassDB::bind_method(D_METHOD("instantiate_missing_test_cases"), &TestSuite::instantiate_missing_test_cases);
+
+        ClassDB::bind_method(D_METHOD("get_parallel"), &TestSuite::get_parallel);
+        ClassDB::bind_method(D_METHOD("set_parallel", "parallel"), &TestSuite::set_parallel);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "parallel"), "set_parallel", "get_parallel");
+
+        ClassDB::bind_method(D_METHOD("get_use_result_cache"), &TestSuite::get_use_result_cache);
+        ClassDB::bind_method(D_METHOD("set_use_result_cache", "use_result_cache"), &TestSuite::set_use_result_cache);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_result_cache"), "set_use_result_cache", "get_use_result_cache");
+
+        ClassDB::bind_method(D_METHOD("get_result_cache_path"), &TestSuite::get_result_cache_path);
+        ClassDB::bind_method(D_METHOD("set_result_cache_path", "result_cache_path"), &TestSuite::set_result_cache_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "result_cache_path", PROPERTY_HINT_SAVE_FILE, "*.json"), "set_result_cache_path", "get_result_cache_path");
+
+        ClassDB::bind_method(D_METHOD("get_fail_fast"), &TestSuite::get_fail_fast);
+        ClassDB::bind_method(D_METHOD("set_fail_fast", "fail_fast"), &TestSuite::set_fail_fast);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "fail_fast"), "set_fail_fast", "get_fail_fast");
+
+        ClassDB::bind_method(D_METHOD("get_stopped_early"), &TestSuite::get_stopped_early);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "stopped_early", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_stopped_early");
+
+        ClassDB::bind_method(D_METHOD("get_watch"), &TestSuite::get_watch);
+        ClassDB::bind_method(D_METHOD("set_watch", "watch"), &TestSuite::set_watch);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "watch"), "set_watch", "get_watch");
+
+        ClassDB::bind_method(D_METHOD("get_previous_results"), &TestSuite::get_previous_results);
+        ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "previous_results", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_previous_results");
+
+        ClassDB::bind_method(D_METHOD("get_record_impact"), &TestSuite::get_record_impact);
+        ClassDB::bind_method(D_METHOD("set_record_impact", "record_impact"), &TestSuite::set_record_impact);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "record_impact"), "set_record_impact", "get_record_impact");
+
+        ClassDB::bind_method(D_METHOD("get_affected_only"), &TestSuite::get_affected_only);
+        ClassDB::bind_method(D_METHOD("set_affected_only", "affected_only"), &TestSuite::set_affected_only);
+        ADD_PROPERTY(PropertyInfo(Variant::BOOL, "affected_only"), "set_affected_only", "get_affected_only");
+
+        ClassDB::bind_method(D_METHOD("get_impact_map_path"), &TestSuite::get_impact_map_path);
+        ClassDB::bind_method(D_METHOD("set_impact_map_path", "impact_map_path"), &TestSuite::set_impact_map_path);
+        ADD_PROPERTY(PropertyInfo(Variant::STRING, "impact_map_path", PROPERTY_HINT_SAVE_FILE, "*.json"), "set_impact_map_path", "get_impact_map_path");
+
         ClassDB::bind_method(D_METHOD("get_passed_test_cases"), &TestSuite::get_passed_test_cases);
         ADD_PROPERTY(PropertyInfo(Variant::INT, "passed_test_cases", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_passed_test_cases");
 
@@ -113,5 +1046,17 @@ namespace godot::Testing
 
         ClassDB::bind_method(D_METHOD("get_errored_test_cases"), &TestSuite::get_errored_test_cases);
         ADD_PROPERTY(PropertyInfo(Variant::INT, "errored_test_cases", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_errored_test_cases");
+
+        ClassDB::bind_method(D_METHOD("get_wall_clock_usec"), &TestSuite::get_wall_clock_usec);
+        ADD_PROPERTY(PropertyInfo(Variant::INT, "wall_clock_usec", PROPERTY_HINT_NONE, "suffix:us", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_wall_clock_usec");
+
+        ClassDB::bind_method(D_METHOD("get_speedup"), &TestSuite::get_speedup);
+        ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "speedup", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_READ_ONLY | PROPERTY_USAGE_EDITOR), "", "get_speedup");
+
+        ClassDB::bind_method(D_METHOD("get_report_writers"), &TestSuite::get_report_writers);
+        ClassDB::bind_method(D_METHOD("set_report_writers", "report_writers"), &TestSuite::set_report_writers);
+        ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "report_writers", PROPERTY_HINT_TYPE_STRING, vformat("%d/%d:ReportWriter", Variant::OBJECT, PROPERTY_HINT_RESOURCE_TYPE)), "set_report_writers", "get_report_writers");
+
+        ClassDB::bind_method(D_METHOD("get_test_reports"), &TestSuite::get_test_reports);
     }
 }
\ No newline at end of file
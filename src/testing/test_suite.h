@@ -5,10 +5,17 @@
 #include <godot_cpp/core/math.hpp>
 #include <godot_cpp/classes/node.hpp>
 
+#include <atomic>
 #include <vector>
 #include <utility>
 
+#include "testing/output_sink.h"
 #include "testing/test_case.h"
+#include "testing/async_test_case.h"
+#include "testing/benchmark_case.h"
+#include "testing/stress_test_case.h"
+#include "testing/test_impact_map.h"
+#include "testing/test_result_cache.h"
 #include "testing/test_macros.h"
 
 namespace godot::Testing
@@ -18,33 +25,220 @@ namespace godot::Testing
         GDCLASS(TestSuite, Node)
 
     public:
+        TestSuite();
+
         void run_all_test_cases();
 
         Callable get_all_test_cases_runner();
 
+        // Runs the test cases over successive frames, spending about frame_budget_usec on them per
+        // frame (but always at least one test case). Emits run_progressed after each test case, and
+        // run_finished or run_cancelled at the end.
+        void start_incremental_run();
+        void cancel_run();
+        bool is_running() const;
+
+        Callable get_incremental_runner();
+
+        std::int64_t get_frame_budget_usec() const;
+        void set_frame_budget_usec(std::int64_t frame_budget_usec);
+
+        virtual void _process(double delta) override;
+
         bool get_suppress_details() const;
         void set_suppress_details(bool suppress_details);
 
+        bool get_time_checks() const;
+        void set_time_checks(bool time_checks);
+
+        std::int64_t get_slowest_count() const;
+        void set_slowest_count(std::int64_t slowest_count);
+
+        Ref<OutputSink> get_output_sink() const;
+        void set_output_sink(const Ref<OutputSink>& output_sink);
+
+        PackedStringArray get_test_case_names() const;
+
+        // Only test cases whose name or class matches one of these patterns are run (all of them if empty)
+        PackedStringArray get_test_case_filter() const;
+        void set_test_case_filter(const PackedStringArray& test_case_filter);
+
+        // The test cases that would be run, in registration order
+        TypedArray<TestCase> get_selected_test_cases() const;
+
+        // With the result cache, test cases that did not pass last time run first, and the rest
+        // run shortest first. Each run records its results in the cache.
+        bool get_use_result_cache() const;
+        void set_use_result_cache(bool use_result_cache);
+
+        String get_result_cache_path() const;
+        void set_result_cache_path(const String& result_cache_path);
+
+        // Stops the run after the first test case that fails or errors
+        bool get_fail_fast() const;
+        void set_fail_fast(bool fail_fast);
+
+        // Whether the last run was stopped early by fail_fast
+        bool get_stopped_early() const;
+
+        // Records which source files each test case covers in the impact map (which needs an
+        // extension built with coverage=yes). Test cases run one at a time while recording.
+        bool get_record_impact() const;
+        void set_record_impact(bool record_impact);
+
+        // Only runs the test cases whose covered source files changed since they were recorded
+        // (and those that have not been recorded)
+        bool get_affected_only() const;
+        void set_affected_only(bool affected_only);
+
+        String get_impact_map_path() const;
+        void set_impact_map_path(const String& impact_map_path);
+
+        // In watch mode, the test suite runs all of its test cases again whenever the extension
+        // that defines it is hot-reloaded (Godot only notifies instances of the re-registered
+        // classes), and lists the test cases whose results changed since the previous run
+        bool get_watch() const;
+        void set_watch(bool watch);
+
+        // The result of each test case before the last watch-mode run, keyed by test case class
+        Dictionary get_previous_results() const;
+
+        // Creates the test cases that have not been set, such as when the test suite was created
+        // from its class instead of being loaded from a scene
+        void instantiate_missing_test_cases();
+
+        bool get_parallel() const;
+        void set_parallel(bool parallel);
+
         std::int64_t get_passed_test_cases() const;
         std::int64_t get_mixed_test_cases() const;
         std::int64_t get_failed_test_cases() const;
         std::int64_t get_errored_test_cases() const;
 
+        std::int64_t get_wall_clock_usec() const;
+        double get_speedup() const;
+
+        TypedArray<ReportWriter> get_report_writers() const;
+        void set_report_writers(const TypedArray<ReportWriter>& report_writers);
+
+        // The reports of the last run of each test case, in registration order
+        Array get_test_reports() const;
+
     protected:
         static void _bind_methods();
+        void _notification(int p_what);
 
         std::vector<std::pair<String, Ref<TestCase>>> m_all_test_cases;
 
     private:
+        // Prints the header and returns the test cases to run
+        std::vector<Ref<TestCase>> begin_run();
+        // Prints the summary of the given (completed) test cases
+        void finish_run(const std::vector<Ref<TestCase>>& test_cases, bool cancelled = false);
+        void stop_incremental_run();
+
+        std::vector<Ref<TestCase>> get_synchronous_test_cases(const std::vector<Ref<TestCase>>& test_cases) const;
+        // Starts all asynchronous test cases of the run at once, and finishes the run once they
+        // have all completed (or right away if there are none)
+        void start_async_test_cases();
+        void on_async_test_case_completed();
+
+        Ref<OutputSink> create_buffer_output_sink() const;
+
+        void run_test_case_serially(const Ref<TestCase>& test_case);
+        // Returns the test cases that ran (all of them unless fail_fast stopped the run)
+        std::vector<Ref<TestCase>> run_test_cases_in_parallel(const std::vector<Ref<TestCase>>& test_cases);
+        void run_parallel_test_case(std::uint32_t index);
+        void count_test_case_results(const Ref<TestCase>& test_case);
+        // Returns true (and marks the run as stopped early) if fail_fast applies to the test case
+        bool should_stop_after(const Ref<TestCase>& test_case);
+        void order_by_result_cache(std::vector<Ref<TestCase>>& test_cases) const;
+        void record_in_result_cache(const std::vector<Ref<TestCase>>& test_cases);
+        void run_after_reload();
+        // Prints the test cases whose results differ from the previous watch-mode run, and
+        // remembers the new results for the next one
+        void compare_with_previous_results(const std::vector<Ref<TestCase>>& test_cases);
+        void write_test_case_report(const Ref<TestCase>& test_case);
+        void report_parallel_leaks();
+        void print_slowest(const std::vector<Ref<TestCase>>& test_cases);
+        bool matches_test_case_filter(const String& test_case_name, const Ref<TestCase>& test_case) const;
+
         Callable m_all_test_cases_runner = Callable(this, "run_all_test_cases");
+        Callable m_incremental_runner = Callable(this, "start_incremental_run");
+
+        std::int64_t m_frame_budget_usec = 8000;
+        bool m_incremental_run_active = false;
+        std::vector<Ref<TestCase>> m_incremental_test_cases;
+        std::size_t m_incremental_next_index = 0;
+
+        // The test cases selected for the current run
+        std::vector<Ref<TestCase>> m_run_test_cases;
+
+        // The settings a test case had before the test suite overrode them for a run
+        struct TestCaseSettings
+        {
+            bool suppress_details;
+            bool time_checks;
+            Ref<OutputSink> output_sink;
+        };
+
+        std::vector<Ref<TestCase>> m_async_test_cases;
+        std::vector<TestCaseSettings> m_async_previous_settings;
+        std::size_t m_pending_async_test_cases = 0;
+        bool m_cancelling = false;
+
+        std::uint64_t m_run_start_usec = 0;
+        bool m_ran_in_parallel = false;
 
         bool m_suppress_details = true;
+        bool m_time_checks = false;
+
+        // How many of the slowest test cases and checks are listed in the summary (zero for none)
+        std::int64_t m_slowest_count = 5;
+
+        Ref<OutputSink> m_output_sink;
+
+        PackedStringArray m_test_case_filter;
+
+        // Each test case's report is written to these as soon as the test case is done
+        TypedArray<ReportWriter> m_report_writers;
+
+        // In parallel mode, thread-safe test cases are run on the WorkerThreadPool
+        bool m_parallel = false;
+        std::vector<Ref<TestCase>> m_parallel_test_cases;
+        std::vector<std::uint8_t> m_parallel_test_cases_ran;
+        // Leaks can only be told apart for the whole parallel batch, whose growth is kept here if
+        // any of its test cases checks for leaks (and counts as an errored test case)
+        bool m_parallel_leaked = false;
+        LeakSnapshot m_parallel_leak_growth;
+        std::atomic<bool> m_parallel_stop{false};
+
+        bool m_use_result_cache = false;
+        String m_result_cache_path = TestResultCache::DEFAULT_PATH;
+        Ref<TestResultCache> m_result_cache;
+
+        bool m_fail_fast = false;
+        bool m_stopped_early = false;
+
+        bool m_record_impact = false;
+        bool m_affected_only = false;
+        String m_impact_map_path = TestImpactMap::DEFAULT_PATH;
+        Ref<TestImpactMap> m_impact_map;
+
+        // The extension's own instance data is recreated on a hot reload, so the results that
+        // watch mode compares against are kept in a file instead
+        static constexpr const char* WATCH_RESULTS_PATH = "user://test_watch_results.json";
+        bool m_watch = false;
+        Dictionary m_previous_results;
 
         std::int64_t m_passed_test_cases = 0;
         std::int64_t m_mixed_test_cases = 0;
         std::int64_t m_failed_test_cases = 0;
         std::int64_t m_errored_test_cases = 0;
 
+        std::int64_t m_wall_clock_usec = 0;
+        double m_speedup = 1.0;
+
         const String LINE = String("=").repeat(80);
     };
 